@@ -0,0 +1,33 @@
+#include <iostream>
+#include "routing_api.h"
+
+/// Prints the size and shape of a routing graph, e.g. to size a server
+/// before deploying a new map.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: ./build/bin/graph_stats <graph file> [<graph file> ...]" << std::endl;
+        return 1;
+    }
+
+    routing::RoutingAPI api;
+    int failures = 0;
+    for (int i = 1; i < argc; i++) {
+        std::cout << "== " << argv[i] << std::endl;
+        routing::IGraph* graph = NULL;
+        try {
+            graph = api.LoadFromFile(argv[i]);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Failed to load: " << e.what() << std::endl;
+        }
+        if (!graph) {
+            std::cerr << "No graph loaded from " << argv[i] << std::endl;
+            failures++;
+            continue;
+        }
+        std::cout << graph->GetStats();
+        delete graph;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
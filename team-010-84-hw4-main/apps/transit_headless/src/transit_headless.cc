@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "NullController.h"
+#include "Scenario.h"
+#include "SimulationModel.h"
+#include "routing_api.h"
+#include "routing_stats.h"
+
+namespace {
+
+void usage() {
+    std::cerr << "Usage: ./build/bin/transit_headless <scene.json> [<trips.json> ...]" << std::endl
+              << "    [--map <graph file>]   default libs/routing/data/umn.osm" << std::endl
+              << "    [--dt <seconds>]       simulated seconds per update, default 0.1" << std::endl
+              << "    [--duration <seconds>] stop after this much simulated time, default 86400" << std::endl
+              << "    [--speed <factor>]     run at most this many times real time, default unlimited" << std::endl
+              << "    [--threads <n>]        threads updating entities, default 1" << std::endl
+              << "    [--out <file>]         write the report here instead of stdout" << std::endl;
+}
+
+JsonObject routingReport() {
+    const routing::RoutingMetrics& metrics = routing::RoutingMetrics::Global();
+    JsonObject report;
+    report["queries"] = static_cast<double>(metrics.queries());
+    report["failures"] = static_cast<double>(metrics.failures());
+    report["nodesSettled"] = static_cast<double>(metrics.nodesSettled());
+    uint64_t count = metrics.totalTime().GetCount();
+    report["meanMicros"] = count ? static_cast<double>(metrics.totalTime().GetSum()) / count : 0.0;
+    report["p95Micros"] = static_cast<double>(metrics.totalTime().Quantile(0.95));
+    return report;
+}
+
+}
+
+/// Replays a scene and trip requests through the simulation without a view,
+/// as fast as the CPU allows, and reports delivery KPIs as JSON. Trip files
+/// use the scene format; entries may carry a "time" in simulated seconds.
+int main(int argc, char** argv) {
+    std::vector<std::string> scripts;
+    std::string mapFile = "libs/routing/data/umn.osm";
+    std::string outFile;
+    double dt = 0.1;
+    double duration = 86400;
+    double speed = 0;
+    int threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--map" && hasValue) mapFile = argv[++i];
+        else if (arg == "--dt" && hasValue) dt = std::atof(argv[++i]);
+        else if (arg == "--duration" && hasValue) duration = std::atof(argv[++i]);
+        else if (arg == "--speed" && hasValue) speed = std::atof(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = std::atoi(argv[++i]);
+        else if (arg == "--out" && hasValue) outFile = argv[++i];
+        else if (arg.rfind("--", 0) == 0) {
+            usage();
+            return 1;
+        }
+        else scripts.push_back(arg);
+    }
+    if (scripts.empty() || dt <= 0) {
+        usage();
+        return 1;
+    }
+
+    Scenario scenario;
+    try {
+        for (const std::string& script : scripts) scenario.load(script);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load scenario: " << e.what() << std::endl;
+        return 1;
+    }
+
+    routing::RoutingAPI api;
+    routing::IGraph* graph = NULL;
+    try {
+        graph = api.LoadFromFile(mapFile);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load: " << e.what() << std::endl;
+    }
+    if (!graph) {
+        std::cerr << "No graph loaded from " << mapFile << std::endl;
+        return 1;
+    }
+
+    // entities announce themselves on stdout; keep it for the report
+    std::streambuf* console = std::cout.rdbuf(NULL);
+    NullController controller;
+    long updates = 0;
+    auto started = std::chrono::steady_clock::now();
+    {
+        SimulationModel model(controller);
+        model.setGraph(graph);
+        model.setWorkerThreads(threads);
+
+        while (controller.isAlive() && model.getTime() < duration) {
+            scenario.apply(model, model.getTime());
+            if (scenario.done() && model.getDeliveryLog().outstanding() == 0
+                    && model.getTime() >= scenario.endTime()) {
+                break;
+            }
+            // nothing moves until the next trip or event, so jump to it, and
+            // apply whatever is due there before updating
+            double before = model.getTime();
+            model.skipTo(std::min(scenario.nextTime(), duration));
+            if (model.getTime() >= duration) break;
+            if (model.getTime() > before) continue;
+            model.update(dt);
+            updates++;
+
+            if (speed > 0) {
+                // hold simulated time to at most speed times wall-clock time
+                std::chrono::duration<double> due(model.getTime() / speed);
+                std::this_thread::sleep_until(started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(due));
+            }
+        }
+
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - started;
+        JsonObject report;
+        report["simulatedSeconds"] = model.getTime();
+        report["wallSeconds"] = wall.count();
+        report["updates"] = static_cast<double>(updates);
+        report["speedup"] = wall.count() > 0 ? model.getTime() / wall.count() : 0.0;
+        report["scriptComplete"] = scenario.done();
+        report["deliveries"] = model.getDeliveryLog().summary(model.getTime());
+        report["routing"] = routingReport();
+
+        std::cout.rdbuf(console);
+        std::cout.clear();
+        if (outFile.empty()) {
+            std::cout << report.toString() << std::endl;
+        }
+        else {
+            std::ofstream out(outFile);
+            if (!out) {
+                std::cerr << "Cannot write " << outFile << std::endl;
+                return 1;
+            }
+            out << report.toString() << std::endl;
+        }
+    }
+
+    delete graph;
+    return 0;
+}
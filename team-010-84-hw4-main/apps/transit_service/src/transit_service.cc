@@ -1,97 +1,107 @@
 #include <map>
 #include <chrono>
+#include <future>
 #include "WebServer.h"
-#include "SimulationModel.h"
+#include "SimulationThread.h"
+#include "StateFrame.h"
+#include "ViewState.h"
 #include "routing_api.h"
 
+/// Converts a routing histogram to {count, sum, buckets: [...]}, where bucket i
+/// counts values in [2^(i-1), 2^i).
+JsonObject histogramJson(const routing::Histogram& histogram) {
+    JsonObject result;
+    JsonArray buckets;
+    for (uint64_t count : histogram.GetBuckets()) {
+        buckets.push(static_cast<double>(count));
+    }
+    result["count"] = static_cast<double>(histogram.GetCount());
+    result["sum"] = static_cast<double>(histogram.GetSum());
+    result["buckets"] = buckets;
+    return result;
+}
+
+/// Exports the path query counters so slow dispatches can be traced to routing.
+JsonObject routingMetrics(const routing::RoutingMetrics& metrics) {
+    JsonObject result;
+    result["queries"] = static_cast<double>(metrics.queries());
+    result["failures"] = static_cast<double>(metrics.failures());
+    result["nodesSettled"] = static_cast<double>(metrics.nodesSettled());
+    result["edgesRelaxed"] = static_cast<double>(metrics.edgesRelaxed());
+    result["heapPushes"] = static_cast<double>(metrics.heapPushes());
+    result["heapPops"] = static_cast<double>(metrics.heapPops());
+    result["peakFrontier"] = static_cast<double>(metrics.peakFrontier());
+    result["totalMicros"] = histogramJson(metrics.totalTime());
+    result["snapMicros"] = histogramJson(metrics.snapTime());
+    result["settledPerQuery"] = histogramJson(metrics.settled());
+    return result;
+}
+
 //--------------------  Controller ----------------------------
 
-/// A Transit Service that communicates with a web page through web sockets.  It also acts as the controller
-/// in the model view controller pattern.
-class TransitService : public JsonSession, public IController {
+/// A Transit Service that communicates with a web page through web sockets.  The
+/// simulation runs on its own thread; a session only forwards commands to it and
+/// sends the latest snapshot back to the view.
+class TransitService : public JsonSession {
 public:
-    TransitService(SimulationModel& model) : model(model), start(std::chrono::system_clock::now()), time(0.0) {
-        routing::RoutingAPI api;
-        routing::IGraph* graph = api.LoadFromFile("libs/routing/data/umn.osm");
-        model.setGraph(graph);
-    }
+    TransitService(SimulationThread& simulation) : simulation(simulation), binary(false) {}
 
     /// Handles specific commands from the web server
     void receiveCommand(const std::string& cmd, JsonObject& data, JsonObject& returnValue) {
         // std::cout << cmd << ": " << data << std::endl;
         if (cmd == "CreateEntity") {
-            model.createEntity(data);
+            simulation.post([data](SimulationModel& model) mutable { model.createEntity(data); });
         }
         else if (cmd == "ScheduleTrip") {
-            model.scheduleTrip(data);
+            simulation.post([data](SimulationModel& model) mutable { model.scheduleTrip(data); });
         }
         else if (cmd == "ping") {
             returnValue["response"] = data;
         }
+        else if (cmd == "SetFormat") {
+            // views that can decode StateFrames ask for them; anything else
+            // keeps getting JSON
+            binary = data.contains("format") && static_cast<std::string>(data["format"]) == "binary";
+            returnValue["format"] = std::string(binary ? "binary" : "json");
+        }
+        else if (cmd == "GetRoutingMetrics") {
+            returnValue["metrics"] = routingMetrics(routing::RoutingMetrics::Global());
+        }
         else if (cmd == "Update") {
-            updateEntites.clear();
-
-            std::chrono::time_point<std::chrono::system_clock> end = std::chrono::system_clock::now();
-            std::chrono::duration<double> diff = end - start;
-            double delta = diff.count() - time;
-            time += delta;
-
+            // the simulation keeps its own time; viewers only set its speed and
+            // read where things are
             double simSpeed = data["simSpeed"];
-            delta *= simSpeed;
+            simulation.setSpeed(simSpeed);
 
-            if (delta > 0.1) {
-                for (float f = 0.0; f < delta; f+=0.01) {
-                    model.update(0.01);
+            const WorldSnapshot& snapshot = simulation.latest();
+            if (snapshot.tick == view.getTick()) {
+                return;
+            }
+            // only what visibly changed since this view was last sent it
+            std::vector<const EntityState*> changed = view.update(snapshot);
+            if (changed.empty()) {
+                return;
+            }
+            if (binary) {
+                StateFrame frame(snapshot.tick);
+                for (const EntityState* entity : changed) {
+                    frame.add(*entity);
                 }
+                sendMessage(frame.toText());
             }
             else {
-                model.update(delta);
-            }
-
-            for (auto& [id, entity] : updateEntites) {
-                sendEntity("UpdateEntity", *entity);
+                for (const EntityState* entity : changed) {
+                    sendEventToView("UpdateEntity", entity->toJson());
+                }
             }
         }
         else if (cmd == "stopSimulation")
         {
             std::cout << "Stop command administered\n";
-            model.stop();
+            simulation.post([](SimulationModel& model) { model.stop(); });
         }
     }
 
-    void sendEntity(const std::string& event, const IEntity& entity, bool includeDetails = true) {
-        //JsonObject details = entity.GetDetails();
-        JsonObject details;
-        if (includeDetails) {
-            details["details"] = entity.getDetails();
-        }
-        details["id"] = entity.getId();
-        Vector3 pos_ = entity.getPosition();
-        Vector3 dir_ = entity.getDirection();
-        JsonArray pos = {pos_.x, pos_.y, pos_.z};
-        JsonArray dir = {dir_.x, dir_.y, dir_.z};
-        details["pos"] = pos;
-        details["dir"] = dir;
-        std::string col_ = entity.getColor();
-        if(col_ != "") details["color"] = col_;
-        sendEventToView(event, details);
-    }
-
-    void addEntity(const IEntity& entity) {
-        sendEntity("AddEntity", entity, true);
-    }
-    
-    void updateEntity(const IEntity& entity) {
-        updateEntites[entity.getId()] = &entity;
-    }
-
-    void removeEntity(const IEntity& entity) {
-        JsonObject details;
-        details["id"] = entity.getId();
-        updateEntites.erase(entity.getId());
-        sendEventToView("RemoveEntity", details);
-    }
-
     /// Allows messages to be passed back to the view
     void sendEventToView(const std::string& event, const JsonObject& details) {
         JsonObject eventData;
@@ -100,75 +110,44 @@ public:
         sendMessage(eventData.toString());
     }
 
-    /*void updateBatteries(const int (&batteries)[3]){
-        JsonObject batteryData;
-        batteryData["battery0"] = batteries[0];
-        batteryData["battery1"] = batteries[1];
-        batteryData["battery2"] = batteries[2];
-        sendMessage(batteryData.toString());
-        std::cout << "sending message, light: " << batteries[0] << "\n";
-    }*/
-
-    void stop() {}
-
-    bool isAlive(){ return true; }
-
 private:
-    // Simulation Model
-    SimulationModel& model;
-    // Used for tracking time since last update
-    std::chrono::time_point<std::chrono::system_clock> start;
-    // The total time the server has been running.
-    double time;
-    // Current entities to update
-    std::map<int, const IEntity*> updateEntites;
+    // Simulation shared by every session
+    SimulationThread& simulation;
+    // What this view was last sent of each entity
+    ViewState view;
+    // Whether the view takes StateFrames instead of UpdateEntity messages
+    bool binary;
 };
 
 
 //--------------------  View / Web Server Code ----------------------------
 
-/// The TransitWebServer holds the simulation and updates sessions.
-class TransitWebServer : public WebServerBase, public IController {
+/// The TransitWebServer holds the simulation and relays its events to sessions.
+class TransitWebServer : public WebServerBase {
 public:
-	TransitWebServer(int port = 8081, const std::string& webDir = ".") : WebServerBase(port, webDir), model(*this), alive_(true) {}
-    void addEntity(const IEntity& entity) {
-        for (int i = 0; i < sessions.size(); i++) {
-            static_cast<TransitService*>(sessions[i])->addEntity(entity);
-        }
-    }
-    
-    void updateEntity(const IEntity& entity) {
-        for (int i = 0; i < sessions.size(); i++) {
-            static_cast<TransitService*>(sessions[i])->updateEntity(entity);
-        }
-    }
+	TransitWebServer(int port = 8081, const std::string& webDir = ".", double tickRate = 60) : WebServerBase(port, webDir), simulation(tickRate) {}
 
-    void removeEntity(const IEntity& entity) {
-        for (int i = 0; i < sessions.size(); i++) {
-            static_cast<TransitService*>(sessions[i])->removeEntity(entity);
-        }
-    }
+    void setGraph(const routing::IGraph* graph) { simulation.getModel().setGraph(graph); }
 
-    void sendEventToView(const std::string& event, const JsonObject& details) {
-        for (int i = 0; i < sessions.size(); i++) {
-            static_cast<TransitService*>(sessions[i])->sendEventToView(event, details);
-        }
-    }
+    void setWorkerThreads(int threads) { simulation.getModel().setWorkerThreads(threads); }
 
-    /*void updateBatteries(const int (&batteries)[3]) {
-        for (int i = 0; i < sessions.size(); i++) {
-            static_cast<TransitService*>(sessions[i])->updateBatteries(batteries);
+    void start() { simulation.start(); }
+
+    /// Sends every session the events the simulation raised since the last call.
+    void relayEvents() {
+        for (const SimulationEvent& e : simulation.drainEvents()) {
+            for (int i = 0; i < sessions.size(); i++) {
+                static_cast<TransitService*>(sessions[i])->sendEventToView(e.event, e.details);
+            }
         }
-    }*/
+    }
 
-    void stop() { alive_ = false; }
-    bool isAlive() { return alive_; }
+    bool isAlive() { return simulation.isAlive(); }
 
 protected:
-	Session* createSession() { return new TransitService(model); }
+	Session* createSession() { return new TransitService(simulation); }
 private:
-    SimulationModel model;
-    bool alive_;
+    SimulationThread simulation;
 };
 
 /// The main program that handles starting the web sockets service.
@@ -176,13 +155,38 @@ int main(int argc, char**argv) {
     if (argc > 1) {
         int port = std::atoi(argv[1]);
         std::string webDir = std::string(argv[2]);
-        TransitWebServer server(port, webDir);
+        // parse the map while the web server starts up
+        routing::RoutingAPI api;
+        std::string mapFile = "libs/routing/data/umn.osm";
+        std::future<routing::IGraph*> graph = api.PreloadFromFile(mapFile);
+        double tickRate = argc > 4 ? std::atof(argv[4]) : 60;
+        // outlives the server, whose simulation reads it
+        std::unique_ptr<routing::IGraph> map;
+        TransitWebServer server(port, webDir, tickRate);
+        if (argc > 3) {
+            server.setWorkerThreads(std::atoi(argv[3]));
+        }
+        try {
+            map.reset(graph.get());
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Failed to load map: " << e.what() << std::endl;
+            return 1;
+        }
+        if (!map) {
+            std::cerr << "No graph loaded from " << mapFile << std::endl;
+            return 1;
+        }
+        std::cout << "Loaded map:" << std::endl << map->GetStats();
+        server.setGraph(map.get());
+        server.start();
         while (server.isAlive()) {
             server.service();
+            server.relayEvents();
         }
     }
     else {
-        std::cout << "Usage: ./build/bin/transit_service <port> apps/transit_service/web/" << std::endl;
+        std::cout << "Usage: ./build/bin/transit_service <port> apps/transit_service/web/ [threads] [tickRate]" << std::endl;
     }
 
     return 0;
@@ -2,13 +2,24 @@ function WSApi(host = null) {
     var self = this;
     var hostname = host != null ? host : location.hostname+(location.port ? ':'+location.port: '');
     this.socket = new WebSocket("ws://" + hostname, "web_server");
+    this.socket.binaryType = "arraybuffer";
     this.callbacks = {};
     this.requestId = 0;
     this.id = null;
 
     this.onmessage = null;
+    // called with decoded entity states once the server sends StateFrames
+    this.onstates = null;
+    this.binary = false;
 
     this.socket.onmessage = function (msg) {
+        if (msg.data instanceof ArrayBuffer || msg.data.charAt(0) == WSApi.STATE_MARKER) {
+            if (self.onstates) {
+                self.onstates(WSApi.decodeStates(msg.data));
+            }
+            return;
+        }
+
         var data = JSON.parse(msg.data);
 
         if (typeof(data) == 'number') {
@@ -102,4 +113,58 @@ WSApi.prototype.sendCommand = function(cmd, data, calcVal, isPost = false) {
         });
     }
 
-}
\ No newline at end of file
+}
+
+// StateFrame layout, see libs/transit/include/StateFrame.h
+WSApi.STATE_MARKER = "B";
+WSApi.STATE_HEADER_BYTES = 8;
+WSApi.STATE_RECORD_BYTES = 18;
+WSApi.POSITION_SCALE = 8;
+WSApi.DIRECTION_SCALE = 32767;
+WSApi.HAS_COLOR = 1;
+
+// Asks the server for compact StateFrames instead of an UpdateEntity message
+// per entity. Servers that do not know the format keep sending JSON.
+WSApi.prototype.requestStateFrames = function() {
+    let self = this;
+    return this.sendCommand("SetFormat", { format: "binary" }).then(function(data) {
+        self.binary = data.format == "binary";
+        return self.binary;
+    });
+}
+
+// Decodes a StateFrame, given as an ArrayBuffer or as the base64 text the
+// server sends, into typed arrays: ids, flags, and x, y, z triples of
+// positions and directions.
+WSApi.decodeStates = function(frame) {
+    var buffer = frame;
+    if (!(frame instanceof ArrayBuffer)) {
+        var text = atob(frame.substring(WSApi.STATE_MARKER.length));
+        var bytes = new Uint8Array(text.length);
+        for (var i = 0; i < text.length; i++) {
+            bytes[i] = text.charCodeAt(i);
+        }
+        buffer = bytes.buffer;
+    }
+
+    var view = new DataView(buffer);
+    var count = view.getUint32(4, true);
+    var states = {
+        tick: view.getUint32(0, true),
+        count: count,
+        ids: new Uint32Array(count),
+        flags: new Uint16Array(count),
+        positions: new Float32Array(3 * count),
+        directions: new Float32Array(3 * count)
+    };
+    for (var i = 0; i < count; i++) {
+        var offset = WSApi.STATE_HEADER_BYTES + i * WSApi.STATE_RECORD_BYTES;
+        states.ids[i] = view.getUint32(offset, true);
+        states.flags[i] = view.getUint16(offset + 4, true);
+        for (var j = 0; j < 3; j++) {
+            states.positions[3 * i + j] = view.getInt16(offset + 6 + 2 * j, true) / WSApi.POSITION_SCALE;
+            states.directions[3 * i + j] = view.getInt16(offset + 12 + 2 * j, true) / WSApi.DIRECTION_SCALE;
+        }
+    }
+    return states;
+}
@@ -3,6 +3,9 @@
 let api = new WSApi();
 var connected = false;
 var entities = {};
+var entityColors = {};
+// newest state of entities whose models are still loading, by id
+var pendingStates = {};
 var entityList = [];
 var sceneFile = "scenes/umn.json";
 var sceneModel = "assets/model/umn.obj";
@@ -48,57 +51,14 @@ $( document ).ready(function() {
       if ("event" in data) {
         if (data.event == "AddEntity") {
           console.log(data.details);
+          entityColors[data.details.id] = data.details.color;
           addEntity(data.details);
         }
         if (data.event == "UpdateEntity") {
           //console.log(data.details);
           var e = data.details;
-
-          if (e.id in entities) {
-            var model = entities[e.id];
-            model.position.x = e.pos[0];
-            model.position.y = e.pos[1];
-            model.position.z = e.pos[2];
-            
-            model.position.x = model.position.x/14.2;
-            model.position.y = model.position.y/20.0 - 13.0;
-            model.position.z = model.position.z/14.2;
-
-            model.position.x += model.offset.x;
-            model.position.y += model.offset.y;
-            model.position.z += model.offset.z;
-
-            var dir = new THREE.Vector3(e.dir[0], e.dir[1], e.dir[2]);
-            var pos = new THREE.Vector3();
-            pos.addVectors(dir, model.position);
-
-            var vector = new THREE.Vector3( 0, 1, 0 );
-            vector = model.worldToLocal(vector);
-
-            if(e.color) {
-              model.children[0].traverse((o) => {
-                if(o.isMesh) {
-                  c = o.userData.defaultColor.clone();
-                  c.multiply(new THREE.Color(e.color));
-                  o.material.color.set(c);
-                }
-              });
-            } else {
-              model.children[0].traverse((o) => {
-                if(o.isMesh) {
-                  o.material.color.set(o.userData.defaultColor);
-                }
-              })
-            }
-
-            var adjustedDirVector = model.localToWorld(new THREE.Vector3(0,0,0)).add(dir);
-            model.lookAt(adjustedDirVector);
-          }
-
-          if (currentView >= 0) {
-            controls.target.copy(entities[currentView].position);
-            controls.update();
-          }
+          moveEntity(e.id, e.pos, e.dir, e.color);
+          followCurrentView();
         }
         if (data.event == "RemoveEntity") {
           //console.log(data);
@@ -111,6 +71,18 @@ $( document ).ready(function() {
     alert('<p>Error' + exception);
   }
 
+  // the compact format, when the server offers it
+  api.onstates = function(states) {
+    for (var i = 0; i < states.count; i++) {
+      var id = states.ids[i];
+      var color = states.flags[i] & WSApi.HAS_COLOR ? entityColors[id] : undefined;
+      moveEntity(id, states.positions.subarray(3 * i, 3 * i + 3),
+                 states.directions.subarray(3 * i, 3 * i + 3), color);
+    }
+    followCurrentView();
+  }
+  api.requestStateFrames();
+
   loadScene(sceneFile);
 });
 
@@ -294,6 +266,57 @@ function displayJSON(data) {
   }
 }
 
+// Places an entity's model where the simulation says it is, facing its
+// direction and tinted with its color, if it has one.
+function moveEntity(id, pos, dir, color) {
+  if (!(id in entities)) {
+    // the server may not send it again, so keep it for onLoad
+    pendingStates[id] = {pos: Array.from(pos), dir: Array.from(dir), color: color};
+    return;
+  }
+  var model = entities[id];
+  model.position.x = pos[0];
+  model.position.y = pos[1];
+  model.position.z = pos[2];
+
+  model.position.x = model.position.x/14.2;
+  model.position.y = model.position.y/20.0 - 13.0;
+  model.position.z = model.position.z/14.2;
+
+  model.position.x += model.offset.x;
+  model.position.y += model.offset.y;
+  model.position.z += model.offset.z;
+
+  var direction = new THREE.Vector3(dir[0], dir[1], dir[2]);
+
+  if(color) {
+    model.children[0].traverse((o) => {
+      if(o.isMesh) {
+        c = o.userData.defaultColor.clone();
+        c.multiply(new THREE.Color(color));
+        o.material.color.set(c);
+      }
+    });
+  } else {
+    model.children[0].traverse((o) => {
+      if(o.isMesh) {
+        o.material.color.set(o.userData.defaultColor);
+      }
+    })
+  }
+
+  var adjustedDirVector = model.localToWorld(new THREE.Vector3(0,0,0)).add(direction);
+  model.lookAt(adjustedDirVector);
+}
+
+// Keeps the camera on the entity being followed.
+function followCurrentView() {
+  if (currentView >= 0) {
+    controls.target.copy(entities[currentView].position);
+    controls.update();
+  }
+}
+
 // This function is a helper for loadScene().
 function loadModels() {
   // instantiate a loader
@@ -465,10 +488,20 @@ const onLoad = ( gltf, position, scale, start, duration, details, id ) => {
   scene.add( group );
   entities[id] = group;
   entityList.push(id);
+
+  if (id in pendingStates) {
+    var state = pendingStates[id];
+    delete pendingStates[id];
+    moveEntity(id, state.pos, state.dir, state.color);
+  }
 };
 
 // This function is called whenever a new object needs to be added to the scene.
 function addEntity(data) {
+  // a newer state may have come in already
+  if (!(data.id in pendingStates)) {
+    pendingStates[data.id] = {pos: data.pos, dir: data.dir, color: data.color};
+  }
   $("#entitySelect").append($('<option value="' + data.id + '">' + data.details.name + '</option>'));
   // the loader will report the loading progress to this function
   const onProgress = () => {};
@@ -496,6 +529,8 @@ function removeEntity(id) {
   scene.remove( model );
   $("#entitySelect option[value='" + id + "']").remove();
   delete entities[id];
+  delete entityColors[id];
+  delete pendingStates[id];
   if (currentView == id) {
     currentView = -1;
   }
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BatchDispatcher.h"
+#include "GreedyDispatcher.h"
+#include "NullController.h"
+#include "Scenario.h"
+#include "SimulationModel.h"
+#include "ThreadPool.h"
+#include "routing_api.h"
+
+namespace {
+
+// Swallows output without keeping any state, so every thread may write to
+// it at once.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) { return c; }
+};
+
+// Parameters that may be swept, in the order runs are enumerated.
+const char* kParameters[] = {"drones", "battery_cap", "weight_cap", "slots", "charge_speed", "dispatcher"};
+
+struct Sweep {
+    Scenario scenario;
+    std::string mapFile = "libs/routing/data/umn.osm";
+    double dt = 0.1;
+    double duration = 86400;
+    std::vector<double> seeds;
+    std::vector<std::string> names;
+    std::vector<JsonArray> values;
+};
+
+struct Run {
+    JsonObject parameters;
+    unsigned int seed;
+    JsonObject report;
+};
+
+JsonObject readJson(const std::string& file) {
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error("cannot open " + file);
+    std::stringstream text;
+    text << in.rdbuf();
+    picojson::value parsed;
+    std::string error = picojson::parse(parsed, text.str());
+    if (!error.empty()) throw std::runtime_error(file + ": " + error);
+    if (!parsed.is<picojson::object>()) throw std::runtime_error(file + ": expected an object");
+    return JsonValue(parsed);
+}
+
+Sweep loadSweep(const std::string& file) {
+    JsonObject config = readJson(file);
+    Sweep sweep;
+    sweep.scenario.load(config["scene"]);
+    if (config.contains("trips")) {
+        JsonArray trips = config["trips"];
+        for (int i = 0; i < trips.size(); i++) sweep.scenario.load(trips[i]);
+    }
+    if (config.contains("map")) sweep.mapFile = static_cast<std::string>(config["map"]);
+    if (config.contains("dt")) sweep.dt = config["dt"];
+    if (config.contains("duration")) sweep.duration = config["duration"];
+    if (config.contains("seeds")) {
+        JsonArray seeds = config["seeds"];
+        for (int i = 0; i < seeds.size(); i++) sweep.seeds.push_back(seeds[i]);
+    }
+    if (sweep.seeds.empty()) sweep.seeds.push_back(1);
+
+    JsonObject axes = config.contains("sweep") ? JsonObject(config["sweep"]) : JsonObject();
+    for (const char* name : kParameters) {
+        if (!axes.contains(name)) continue;
+        JsonArray values = axes[name];
+        if (values.size() == 0) continue;
+        sweep.names.push_back(name);
+        sweep.values.push_back(values);
+    }
+    return sweep;
+}
+
+// Every combination of swept values, for every seed.
+std::vector<Run> enumerate(const Sweep& sweep) {
+    std::vector<Run> runs;
+    std::vector<int> choice(sweep.names.size(), 0);
+    while (true) {
+        for (double seed : sweep.seeds) {
+            Run run;
+            for (int i = 0; i < choice.size(); i++) {
+                run.parameters.getObject()[sweep.names[i]] = sweep.values[i][choice[i]].getValue();
+            }
+            run.seed = seed;
+            runs.push_back(run);
+        }
+        int axis = choice.size() - 1;
+        while (axis >= 0 && ++choice[axis] == sweep.values[axis].size()) {
+            choice[axis--] = 0;
+        }
+        if (axis < 0) break;
+    }
+    return runs;
+}
+
+bool isDrone(const ScenarioCommand& command) {
+    if (command.command != "CreateEntity") return false;
+    std::string type = command.params["type"];
+    return type == "lightDrone" || type == "mediumDrone" || type == "heavyDrone" || type == "drone";
+}
+
+// Applies a run's parameters to the scene's drones and charging stations.
+// A fleet larger than the scene's repeats its drones in turn, each copy a
+// little apart from the last; a smaller one keeps the first drones.
+void configure(Scenario& scenario, const JsonObject& parameters) {
+    const char* droneKeys[] = {"battery_cap", "weight_cap"};
+    const char* stationKeys[] = {"slots", "charge_speed"};
+    std::vector<ScenarioCommand>& commands = scenario.getCommands();
+    for (ScenarioCommand& command : commands) {
+        if (command.command != "CreateEntity") continue;
+        picojson::object& params = command.params.getObject();
+        if (isDrone(command)) {
+            for (const char* key : droneKeys) {
+                if (parameters.contains(key)) params[key] = parameters.getObject().at(key);
+            }
+        }
+        else if (static_cast<std::string>(command.params["type"]) == "chargingStation") {
+            for (const char* key : stationKeys) {
+                if (parameters.contains(key)) params[key] = parameters.getObject().at(key);
+            }
+        }
+    }
+
+    if (!parameters.contains("drones")) return;
+    int fleet = static_cast<double>(parameters["drones"]);
+    std::vector<ScenarioCommand> drones;
+    for (int i = 0; i < commands.size();) {
+        if (isDrone(commands[i]) && drones.size() == fleet) {
+            commands.erase(commands.begin() + i);
+            continue;
+        }
+        if (isDrone(commands[i])) drones.push_back(commands[i]);
+        i++;
+    }
+    if (drones.empty()) return;
+    for (int i = drones.size(); i < fleet; i++) {
+        ScenarioCommand copy = drones[i % drones.size()];
+        int round = i / drones.size();
+        JsonArray position = copy.params["position"];
+        position[0] = static_cast<double>(position[0]) + 5.0 * round;
+        copy.params["position"] = position;
+        std::string name = copy.params["name"];
+        copy.params["name"] = name + "-" + std::to_string(round);
+        scenario.add(copy);
+    }
+}
+
+JsonObject simulate(const Sweep& sweep, const routing::IGraph* graph, const Run& run) {
+    Scenario scenario = sweep.scenario;
+    configure(scenario, run.parameters);
+
+    auto started = std::chrono::steady_clock::now();
+    NullController controller;
+    SimulationModel model(controller);
+    model.setGraph(graph);
+    model.setSeed(run.seed);
+    if (run.parameters.contains("dispatcher")
+            && static_cast<std::string>(run.parameters["dispatcher"]) == "greedy") {
+        model.setDispatcher(new GreedyDispatcher(), 0);
+    }
+
+    while (controller.isAlive() && model.getTime() < sweep.duration) {
+        scenario.apply(model, model.getTime());
+        if (scenario.done() && model.getDeliveryLog().outstanding() == 0
+                && model.getTime() >= scenario.endTime()) {
+            break;
+        }
+        // apply whatever is due at the time skipped to before updating
+        double before = model.getTime();
+        model.skipTo(std::min(scenario.nextTime(), sweep.duration));
+        if (model.getTime() >= sweep.duration) break;
+        if (model.getTime() > before) continue;
+        model.update(sweep.dt);
+    }
+
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - started;
+    JsonObject report;
+    report["simulatedSeconds"] = model.getTime();
+    report["wallSeconds"] = wall.count();
+    report["scriptComplete"] = scenario.done();
+    report["deliveries"] = model.getDeliveryLog().summary(model.getTime());
+    return report;
+}
+
+}
+
+/// Runs one simulation per combination of swept parameters, many at once,
+/// and reports each run's delivery KPIs as JSON. Every run reads the same
+/// map and shares one route cache.
+int main(int argc, char** argv) {
+    std::string sweepFile;
+    std::string outFile;
+    int threads = std::thread::hardware_concurrency();
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) outFile = argv[++i];
+        else if (sweepFile.empty() && arg.rfind("--", 0) != 0) sweepFile = arg;
+        else {
+            sweepFile.clear();
+            break;
+        }
+    }
+    if (sweepFile.empty()) {
+        std::cerr << "Usage: ./build/bin/transit_sweep <sweep.json> [--threads <n>] [--out <file>]" << std::endl;
+        return 1;
+    }
+
+    Sweep sweep;
+    try {
+        sweep = loadSweep(sweepFile);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load sweep: " << e.what() << std::endl;
+        return 1;
+    }
+
+    routing::RoutingAPI api;
+    routing::IGraph* graph = NULL;
+    try {
+        graph = api.LoadFromFile(sweep.mapFile);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load: " << e.what() << std::endl;
+    }
+    if (!graph) {
+        std::cerr << "No graph loaded from " << sweep.mapFile << std::endl;
+        return 1;
+    }
+    routing::RouteCache routes;
+    graph->SetRouteCache(&routes);
+    // build the shared index before the runs race to
+    graph->GetIndex();
+
+    std::vector<Run> runs = enumerate(sweep);
+    std::cerr << runs.size() << " runs on " << std::max(threads, 1) << " threads" << std::endl;
+
+    // entities announce themselves on stdout; keep it for the report
+    NullBuffer discard;
+    std::streambuf* console = std::cout.rdbuf(&discard);
+    auto started = std::chrono::steady_clock::now();
+    ThreadPool pool(std::max(threads, 1) - 1);
+    pool.parallelFor(runs.size(), [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            runs[i].report = simulate(sweep, graph, runs[i]);
+        }
+    });
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - started;
+    std::cout.rdbuf(console);
+
+    JsonArray results;
+    for (const Run& run : runs) {
+        JsonObject result = run.report;
+        result["parameters"] = run.parameters;
+        result["seed"] = static_cast<double>(run.seed);
+        results.push(result);
+    }
+    JsonObject report;
+    report["runs"] = results;
+    report["wallSeconds"] = wall.count();
+    report["routeCacheHits"] = static_cast<double>(routes.hits());
+    report["routeCacheMisses"] = static_cast<double>(routes.misses());
+
+    int status = 0;
+    if (outFile.empty()) {
+        std::cout << report.toString() << std::endl;
+    }
+    else {
+        std::ofstream out(outFile);
+        out << report.toString() << std::endl;
+        if (!out) {
+            std::cerr << "Cannot write " << outFile << std::endl;
+            status = 1;
+        }
+    }
+    delete graph;
+    return status;
+}
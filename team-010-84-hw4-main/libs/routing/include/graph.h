@@ -5,9 +5,16 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <memory>
+#include <mutex>
 #include "routing_strategy.h"
 #include "distance_function.h"
 #include "bounding_box.h"
+#include "graph_index.h"
+#include "graph_stats.h"
+#include "route_cache.h"
+#include "routing_stats.h"
+#include "waypoint_buffer.h"
 
 namespace routing {
 
@@ -21,7 +28,19 @@ public:
 	virtual const std::vector<IGraphNode*>& GetNodes() const = 0;
 	virtual BoundingBox GetBoundingBox() const = 0;
 	virtual const IGraphNode* NearestNode(std::vector<float> point, const DistanceFunction& distance) const = 0;
-	virtual const std::vector< std::vector<float> > GetPath(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& strategy) const = 0;
+	// Every call is recorded in RoutingMetrics::Global(); stats, if given,
+	// also receives this query's numbers.
+	virtual const std::vector< std::vector<float> > GetPath(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& strategy, QueryStats* stats = NULL) const = 0;
+	// Like GetPath, but written straight into a flat buffer that callers
+	// share; a cached route comes back without being copied.
+	virtual std::shared_ptr<const WaypointBuffer> GetRoute(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& strategy, QueryStats* stats = NULL) const = 0;
+	virtual const GraphIndex& GetIndex() const = 0;
+	virtual GraphMemory GetMemoryUsage() const = 0;
+	virtual GraphStats GetStats() const = 0;
+	// Answers GetPath from cache when both ends snap to nodes already
+	// routed between. The cache is not owned and may be shared between
+	// graphs; set it before the graph is queried.
+	virtual void SetRouteCache(RouteCache* cache) = 0;
 };
 
 class IGraphNode {
@@ -37,7 +56,24 @@ public:
 	virtual ~GraphBase() {}
 	BoundingBox GetBoundingBox() const;
 	const IGraphNode* NearestNode(std::vector<float> point, const DistanceFunction& distance) const;
-	const std::vector< std::vector<float> > GetPath(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& strategy) const;
+	const std::vector< std::vector<float> > GetPath(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& strategy, QueryStats* stats = NULL) const;
+	std::shared_ptr<const WaypointBuffer> GetRoute(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& strategy, QueryStats* stats = NULL) const;
+	// Built on first use, so the graph must not change once it is queried.
+	const GraphIndex& GetIndex() const;
+	// Assumes nodes keep their position in a std::vector<float>; graphs
+	// with other node layouts or a name lookup should adjust the result.
+	virtual GraphMemory GetMemoryUsage() const;
+	GraphStats GetStats() const;
+	void SetRouteCache(RouteCache* cache) { routeCache = cache; }
+
+protected:
+	// Lets a graph that already has its edges in CSR form skip Build().
+	void AdoptIndex(GraphIndex&& built);
+
+private:
+	mutable std::once_flag indexBuilt;
+	mutable std::unique_ptr<GraphIndex> index;
+	RouteCache* routeCache = NULL;
 };
 
 }
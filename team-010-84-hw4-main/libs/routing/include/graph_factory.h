@@ -1,6 +1,8 @@
 #ifndef GRAPH_FACTORY_H_
 #define GRAPH_FACTORY_H_
 
+#include <string>
+#include <vector>
 #include "graph.h"
 
 namespace routing {
@@ -9,6 +11,10 @@ class IGraphFactory {
 public:
 	virtual ~IGraphFactory() {}
 	virtual IGraph* Create(const std::string& file) const = 0;
+	// File extensions (lower case, with the dot) this factory reads.
+	virtual std::vector<std::string> GetExtensions() const { return {}; }
+	// True if the first bytes of a file look like this factory's format.
+	virtual bool MatchesSignature(const std::string& header) const { return false; }
 };
 
 }
@@ -0,0 +1,40 @@
+#ifndef GRAPH_FACTORY_REGISTRY_H_
+#define GRAPH_FACTORY_REGISTRY_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "graph_factory.h"
+
+namespace routing {
+
+// Picks the one factory that should read a file instead of trying each in
+// turn. The file's extension is checked first, then its leading bytes.
+// Factories that declare neither are only tried if nothing else matches.
+class GraphFactoryRegistry {
+public:
+	// Number of leading bytes handed to IGraphFactory::MatchesSignature.
+	static const int kHeaderSize = 512;
+
+	GraphFactoryRegistry() {}
+	~GraphFactoryRegistry();
+	GraphFactoryRegistry(const GraphFactoryRegistry&) = delete;
+	GraphFactoryRegistry& operator=(const GraphFactoryRegistry&) = delete;
+
+	// Takes ownership of the factory.
+	void Register(const IGraphFactory* factory);
+	const IGraphFactory* Find(const std::string& file) const;
+	IGraph* Create(const std::string& file) const;
+
+	static std::string Extension(const std::string& file);
+	static std::string ReadHeader(const std::string& file);
+
+private:
+	std::vector<const IGraphFactory*> factories;
+	std::unordered_map<std::string, const IGraphFactory*> byExtension;
+	std::vector<const IGraphFactory*> undeclared;
+};
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef GRAPH_INDEX_H_
+#define GRAPH_INDEX_H_
+
+#include <unordered_map>
+#include <vector>
+
+namespace routing {
+
+class IGraph;
+class IGraphNode;
+
+// Integer id view of a graph for the search algorithms. A node's id is its
+// position in IGraph::GetNodes(). Edges are stored in compressed sparse row
+// form in both directions so searches can walk successors or predecessors
+// without touching the node objects.
+struct GraphIndex {
+	std::unordered_map<const IGraphNode*, int> ids;
+	// successors of node i are targets[offsets[i] .. offsets[i+1])
+	std::vector<int> offsets;
+	std::vector<int> targets;
+	// predecessors of node i are sources[reverseOffsets[i] .. reverseOffsets[i+1])
+	std::vector<int> reverseOffsets;
+	std::vector<int> sources;
+
+	int NumNodes() const { return offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1; }
+	int NumEdges() const { return static_cast<int>(targets.size()); }
+	int OutDegree(int id) const { return offsets[id+1] - offsets[id]; }
+	int IdOf(const IGraphNode* node) const {
+		auto it = ids.find(node);
+		return it == ids.end() ? -1 : it->second;
+	}
+
+	static GraphIndex Build(const IGraph& graph);
+};
+
+}
+
+#endif
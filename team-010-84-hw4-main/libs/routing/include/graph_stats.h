@@ -0,0 +1,37 @@
+#ifndef GRAPH_STATS_H_
+#define GRAPH_STATS_H_
+
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "bounding_box.h"
+
+namespace routing {
+
+// Estimated heap and object bytes held by a graph, by structure.
+struct GraphMemory {
+	size_t nodes = 0;      // node objects and the node list
+	size_t names = 0;
+	size_t adjacency = 0;  // per-node neighbor lists
+	size_t positions = 0;
+	size_t lookup = 0;     // name to node maps
+	size_t index = 0;      // GraphIndex, if it has been built
+	size_t Total() const { return nodes + names + adjacency + positions + lookup + index; }
+};
+
+struct GraphStats {
+	int nodes = 0;
+	int edges = 0;  // directed, so an undirected edge counts twice
+	std::map<int, int> degreeHistogram;  // out-degree -> number of nodes
+	std::vector<int> componentSizes;     // weakly connected, largest first
+	BoundingBox bounds;
+	GraphMemory memory;
+};
+
+std::ostream& operator<<(std::ostream& os, const GraphMemory& memory);
+std::ostream& operator<<(std::ostream& os, const GraphStats& stats);
+
+}
+
+#endif
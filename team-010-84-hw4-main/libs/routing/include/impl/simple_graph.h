@@ -39,6 +39,18 @@ public:
     void AddEdge(const std::string& a, const std::string& b) {
         nodeMap[a]->AddNeighbor(nodeMap[b]);
     }
+    GraphMemory GetMemoryUsage() const {
+        GraphMemory memory = GraphBase::GetMemoryUsage();
+        size_t inlineCapacity = std::string().capacity();
+        for (const auto& kv : nodeMap) {
+            // red-black tree node: three links and a color, plus the pair
+            memory.lookup += 4 * sizeof(void*) + sizeof(std::pair<const std::string, SimpleGraphNode*>);
+            if (kv.first.capacity() > inlineCapacity) {
+                memory.lookup += kv.first.capacity() + 1;
+            }
+        }
+        return memory;
+    }
 
 private:
     std::map<std::string, SimpleGraphNode*> nodeMap;
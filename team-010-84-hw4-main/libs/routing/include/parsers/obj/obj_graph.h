@@ -2,17 +2,44 @@
 #define OBJ_GRAPH_PARSER_H_
 
 #include "graph.h"
-#include "impl/simple_graph.h"
-#include <map>
+#include <string>
 #include <vector>
 
 namespace routing {
 
-class ObjGraph : public SimpleGraph {
+class ObjGraphNode : public IGraphNode {
+public:
+	ObjGraphNode(const std::string& name, const std::vector<float>& position) : name(name), position(position) {}
+	virtual ~ObjGraphNode() {}
+	const std::string& GetName() const { return name; }
+	const std::vector<IGraphNode*>& GetNeighbors() const { return neighbors; }
+	const std::vector<float> GetPosition() const { return position; }
+
+private:
+	friend class ObjGraph;
+	std::string name;
+	std::vector<IGraphNode*> neighbors;
+	std::vector<float> position;
+};
+
+// Graph over the vertices of a Wavefront OBJ file. Every edge of an `f`
+// polygon or `l` polyline becomes an undirected edge, stored once no matter
+// how many faces share it. Nodes are named by their 1-based vertex index.
+class ObjGraph : public GraphBase {
 public:
 	ObjGraph(const std::string& file);
+	virtual ~ObjGraph() {}
+	const IGraphNode* GetNode(const std::string& name) const;
+	const std::vector<IGraphNode*>& GetNodes() const { return nodePointers; }
+
+private:
+	void Parse(const char* begin, const char* end, std::vector<float>& positions, std::vector<std::pair<int, int>>& edges) const;
+	void BuildNodes(const std::vector<float>& positions, const std::vector<std::pair<int, int>>& edges);
+
+	std::vector<ObjGraphNode> nodes;
+	std::vector<IGraphNode*> nodePointers;
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif
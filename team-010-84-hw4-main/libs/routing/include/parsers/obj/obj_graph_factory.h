@@ -1,6 +1,7 @@
 #ifndef OBJ_GRAPH_FACTORY_H_
 #define OBJ_GRAPH_FACTORY_H_
 
+#include <sstream>
 #include "graph_factory.h"
 #include "parsers/obj/obj_graph.h"
 
@@ -10,12 +11,28 @@ class ObjGraphFactory : public IGraphFactory {
 public:
 	virtual ~ObjGraphFactory() {}
 	virtual IGraph* Create(const std::string& file) const {
-		if (file.substr(file.size()-4) != ".obj") {
-			return NULL;
-		}
-
 		return new ObjGraph(file);
 	}
+	virtual std::vector<std::string> GetExtensions() const {
+		return {".obj"};
+	}
+	virtual bool MatchesSignature(const std::string& header) const {
+		// OBJ has no magic number, so look at the first statement
+		std::istringstream lines(header);
+		std::string line;
+		while (std::getline(lines, line)) {
+			std::istringstream tokens(line);
+			std::string keyword;
+			if (!(tokens >> keyword) || keyword[0] == '#') {
+				continue;
+			}
+			return keyword == "v" || keyword == "vt" || keyword == "vn" ||
+				keyword == "f" || keyword == "l" || keyword == "o" ||
+				keyword == "g" || keyword == "s" || keyword == "mtllib" ||
+				keyword == "usemtl";
+		}
+		return false;
+	}
 };
 
 }
@@ -45,6 +45,7 @@ class OSMGraph : public GraphBase {
             { return Contains(name) ? NodeNamed(name) : NULL; }
         const std::vector<IGraphNode*>& GetNodes() const override
             { return nodes_; }
+        GraphMemory GetMemoryUsage() const override;
 
     private:
         vector<IGraphNode*> nodes_;
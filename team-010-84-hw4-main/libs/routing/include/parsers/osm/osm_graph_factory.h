@@ -9,6 +9,8 @@ class OSMGraphFactory : public IGraphFactory {
 public:
 	virtual ~OSMGraphFactory() {}
 	virtual IGraph* Create(const std::string& file) const;
+	virtual std::vector<std::string> GetExtensions() const { return {".osm"}; }
+	virtual bool MatchesSignature(const std::string& header) const;
 };
 
 }
@@ -0,0 +1,66 @@
+#ifndef ROUTE_CACHE_H_
+#define ROUTE_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "waypoint_buffer.h"
+
+namespace routing {
+
+class IGraphNode;
+class RoutingStrategy;
+
+// Paths found between snapped endpoints, shared by every thread querying a
+// graph. Queries snap both ends to the nearest node before searching, so
+// any two queries that snap to the same nodes with the same strategy get
+// the same path. Entries are split over shards, each with its own lock, and
+// each shard drops its oldest entry once full. Strategies are told apart by
+// address, so query with long-lived ones such as AStar::Default().
+class RouteCache {
+public:
+	// capacity is the most paths kept across all shards.
+	explicit RouteCache(size_t capacity = 1 << 16);
+
+	// The cached path, or NULL.
+	std::shared_ptr<const WaypointBuffer> Find(const RoutingStrategy* strategy, const IGraphNode* from, const IGraphNode* to) const;
+	void Insert(const RoutingStrategy* strategy, const IGraphNode* from, const IGraphNode* to, std::shared_ptr<const WaypointBuffer> path);
+
+	uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+	uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+private:
+	static const int kShards = 16;
+
+	struct Key {
+		const RoutingStrategy* strategy;
+		const IGraphNode* from;
+		const IGraphNode* to;
+		bool operator==(const Key& other) const {
+			return strategy == other.strategy && from == other.from && to == other.to;
+		}
+	};
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+	struct Shard {
+		std::mutex mutex;
+		std::unordered_map<Key, std::shared_ptr<const WaypointBuffer>, KeyHash> paths;
+		std::deque<Key> order;
+	};
+
+	Shard& ShardOf(const Key& key) const;
+
+	size_t shardCapacity;
+	mutable Shard shards[kShards];
+	mutable std::atomic<uint64_t> hitCount;
+	mutable std::atomic<uint64_t> missCount;
+};
+
+}
+
+#endif
@@ -13,7 +13,8 @@ public:
 	AStar(DistanceFunction* cost, DistanceFunction* heuristic) : cost(cost), heuristic(heuristic) {}
 	virtual ~AStar();
 
-	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to) const;
+	using RoutingStrategy::GetPath;
+	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const;
 
 	static const RoutingStrategy& Default() {
 		static AStar astar;
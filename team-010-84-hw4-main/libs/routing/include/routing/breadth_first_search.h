@@ -6,11 +6,15 @@
 
 namespace routing {
 
+// Fewest-hops search over the graph's integer index. Each level is expanded
+// either top-down from the frontier or bottom-up from the unvisited nodes,
+// whichever touches fewer edges.
 class BreadthFirstSearch : public RoutingStrategy {
 public:
 	virtual ~BreadthFirstSearch() {}
 
-	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to) const;
+	using RoutingStrategy::GetPath;
+	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const;
 
 	static const RoutingStrategy& Default() {
 		static BreadthFirstSearch bfs;
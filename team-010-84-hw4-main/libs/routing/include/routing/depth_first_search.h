@@ -10,7 +10,8 @@ class DepthFirstSearch : public RoutingStrategy {
 public:
 	virtual ~DepthFirstSearch() {}
 
-	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to) const;
+	using RoutingStrategy::GetPath;
+	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const;
 
 	static const RoutingStrategy& Default() {
 		static DepthFirstSearch dfs;
@@ -1,9 +1,12 @@
 #ifndef ROUTING_API_H_
 #define ROUTING_API_H_
 
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 #include "graph_factory.h"
+#include "graph_factory_registry.h"
 
 namespace routing {
 
@@ -12,10 +15,13 @@ public:
     RoutingAPI();
 	virtual ~RoutingAPI();
     virtual IGraph* LoadFromFile(const std::string& file) const;
+    // Loads on a background thread. The result is safe to use after this
+    // RoutingAPI is destroyed; get() rethrows any parse error.
+    virtual std::future<IGraph*> PreloadFromFile(const std::string& file) const;
     virtual void AddFactory(const IGraphFactory* factory);
 
 private:
-    std::vector<const IGraphFactory*> factories;
+    std::shared_ptr<GraphFactoryRegistry> factories;
 };
 
 }
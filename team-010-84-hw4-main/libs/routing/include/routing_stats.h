@@ -0,0 +1,89 @@
+#ifndef ROUTING_STATS_H_
+#define ROUTING_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace routing {
+
+// Work done by one path query. Strategies fill in the counters that apply
+// to them; for BFS and DFS the "heap" counts are queue and stack operations.
+struct QueryStats {
+	long nodesSettled = 0;
+	long edgesRelaxed = 0;
+	long heapPushes = 0;
+	long heapPops = 0;
+	long peakFrontier = 0;
+	double snapSeconds = 0;    // NearestNode for both endpoints
+	double searchSeconds = 0;  // the strategy's GetPath
+	double totalSeconds = 0;
+	bool found = false;
+	bool cached = false;       // answered from a RouteCache, without a search
+};
+
+// Counts of values in power-of-two buckets: bucket 0 holds 0, bucket i
+// holds [2^(i-1), 2^i). Safe to record into from any thread.
+class Histogram {
+public:
+	static const int kBuckets = 40;
+
+	Histogram();
+	void Record(uint64_t value);
+	std::vector<uint64_t> GetBuckets() const;
+	uint64_t GetCount() const { return count.load(std::memory_order_relaxed); }
+	uint64_t GetSum() const { return sum.load(std::memory_order_relaxed); }
+	// Upper bound of the bucket holding the given quantile, in [0, 1].
+	uint64_t Quantile(double q) const;
+
+private:
+	std::atomic<uint64_t> buckets[kBuckets];
+	std::atomic<uint64_t> count;
+	std::atomic<uint64_t> sum;
+};
+
+// Totals over every query, updated with relaxed atomics so recording never
+// blocks a routing thread.
+class RoutingMetrics {
+public:
+	RoutingMetrics();
+	// Every GraphBase::GetPath call is recorded here.
+	static RoutingMetrics& Global();
+
+	void Record(const QueryStats& stats);
+
+	uint64_t queries() const { return queryCount.load(std::memory_order_relaxed); }
+	uint64_t failures() const { return failureCount.load(std::memory_order_relaxed); }
+	uint64_t cacheHits() const { return cacheHitCount.load(std::memory_order_relaxed); }
+	uint64_t nodesSettled() const { return nodesSettledTotal.load(std::memory_order_relaxed); }
+	uint64_t edgesRelaxed() const { return edgesRelaxedTotal.load(std::memory_order_relaxed); }
+	uint64_t heapPushes() const { return heapPushesTotal.load(std::memory_order_relaxed); }
+	uint64_t heapPops() const { return heapPopsTotal.load(std::memory_order_relaxed); }
+	uint64_t peakFrontier() const { return peakFrontierMax.load(std::memory_order_relaxed); }
+
+	// in microseconds
+	const Histogram& totalTime() const { return totalMicros; }
+	const Histogram& snapTime() const { return snapMicros; }
+	const Histogram& settled() const { return settledPerQuery; }
+
+private:
+	std::atomic<uint64_t> queryCount;
+	std::atomic<uint64_t> failureCount;
+	std::atomic<uint64_t> cacheHitCount;
+	std::atomic<uint64_t> nodesSettledTotal;
+	std::atomic<uint64_t> edgesRelaxedTotal;
+	std::atomic<uint64_t> heapPushesTotal;
+	std::atomic<uint64_t> heapPopsTotal;
+	std::atomic<uint64_t> peakFrontierMax;
+	Histogram totalMicros;
+	Histogram snapMicros;
+	Histogram settledPerQuery;
+};
+
+std::ostream& operator<<(std::ostream& os, const QueryStats& stats);
+std::ostream& operator<<(std::ostream& os, const RoutingMetrics& metrics);
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include "graph.h"
+#include "routing_stats.h"
 
 namespace routing {
 
@@ -12,7 +13,11 @@ class IGraph;
 class RoutingStrategy {
 public:
 	virtual ~RoutingStrategy() {}
-	virtual std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to) const = 0;
+	std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to) const {
+		return GetPath(graph, from, to, NULL);
+	}
+	// stats, if given, receives the search counters for this query.
+	virtual std::vector<std::string> GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const = 0;
 };
 
 }
@@ -0,0 +1,46 @@
+#ifndef WAYPOINT_BUFFER_H_
+#define WAYPOINT_BUFFER_H_
+
+#include <vector>
+
+namespace routing {
+
+// A point on a path and how far along the path it lies. Packed into 16
+// bytes so a path is one flat, aligned array.
+struct alignas(16) Waypoint {
+	float x;
+	float y;
+	float z;
+	float distance;  // from the first waypoint, along the path
+};
+
+// A path as one contiguous array of waypoints with the distance along the
+// path to each, so followers never measure a segment twice. Built once,
+// then shared read-only, e.g. by every entity following the same cached
+// route.
+class WaypointBuffer {
+public:
+	WaypointBuffer() {}
+	explicit WaypointBuffer(const std::vector< std::vector<float> >& path);
+
+	void Reserve(int count) { points.reserve(count); }
+	void Append(float x, float y, float z);
+	void Append(const std::vector<float>& position) { Append(position[0], position[1], position[2]); }
+
+	int Size() const { return static_cast<int>(points.size()); }
+	bool Empty() const { return points.empty(); }
+	const Waypoint& operator[](int i) const { return points[i]; }
+	const Waypoint* Data() const { return points.data(); }
+	// Distance along the whole path.
+	float Length() const { return points.empty() ? 0 : points.back().distance; }
+
+	// The waypoints as {x, y, z} vectors, for code that predates the buffer.
+	std::vector< std::vector<float> > ToVectors() const;
+
+private:
+	std::vector<Waypoint> points;
+};
+
+}
+
+#endif
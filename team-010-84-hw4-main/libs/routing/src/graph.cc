@@ -1,4 +1,5 @@
 #include "graph.h"
+#include <chrono>
 #include <limits>
 
 namespace routing {
@@ -45,22 +46,111 @@ const IGraphNode* GraphBase::NearestNode(std::vector<float> point, const Distanc
     return closestNode;
 }
 
-const std::vector< std::vector<float> > GraphBase::GetPath(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& pathing) const {
+const std::vector< std::vector<float> > GraphBase::GetPath(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& pathing, QueryStats* stats) const {
+    return GetRoute(src, dest, pathing, stats)->ToVectors();
+}
+
+std::shared_ptr<const WaypointBuffer> GraphBase::GetRoute(std::vector<float> src, std::vector<float> dest, const RoutingStrategy& pathing, QueryStats* stats) const {
     using namespace std;
+    typedef chrono::steady_clock clock;
+    QueryStats query;
+
+    clock::time_point start = clock::now();
     const IGraphNode* start_node = NearestNode(src, EuclideanDistance());
     const IGraphNode* end_node = NearestNode(dest, EuclideanDistance());
+    clock::time_point snapped = clock::now();
+
+    shared_ptr<const WaypointBuffer> cached;
+    if (routeCache) {
+        cached = routeCache->Find(&pathing, start_node, end_node);
+    }
+    vector<string> string_path;
+    if (!cached) {
+        string_path = pathing.GetPath(this, start_node->GetName(), end_node->GetName(), &query);
+    }
+    clock::time_point searched = clock::now();
 
-    vector<string> string_path = pathing.GetPath(this, start_node->GetName(), end_node->GetName());
+    query.found = cached || !string_path.empty();
+    query.cached = cached != NULL;
+    query.snapSeconds = chrono::duration<double>(snapped - start).count();
+    query.searchSeconds = chrono::duration<double>(searched - snapped).count();
+    query.totalSeconds = chrono::duration<double>(searched - start).count();
+    RoutingMetrics::Global().Record(query);
+    if (stats) {
+        *stats = query;
+    }
+    if (cached) {
+        return cached;
+    }
 
-    vector< vector<float> > position_path;
-    position_path.push_back(start_node->GetPosition());
+    shared_ptr<WaypointBuffer> route = make_shared<WaypointBuffer>();
+    route->Reserve(string_path.size() + 2);
+    route->Append(start_node->GetPosition());
     for (int i = 0; i < string_path.size(); i++) {
-        position_path.push_back(this->GetNode(string_path[i])->GetPosition());
+        route->Append(this->GetNode(string_path[i])->GetPosition());
+    }
+    route->Append(end_node->GetPosition());
+
+    // failed searches are not cached, so they are still reported as such
+    if (routeCache && query.found) {
+        routeCache->Insert(&pathing, start_node, end_node, route);
     }
-    position_path.push_back(end_node->GetPosition());
+    return route;
+}
+
+const GraphIndex& GraphBase::GetIndex() const {
+    std::call_once(indexBuilt, [this]() {
+        index.reset(new GraphIndex(GraphIndex::Build(*this)));
+    });
+    return *index;
+}
 
-    return position_path; 
+void GraphBase::AdoptIndex(GraphIndex&& built) {
+    std::call_once(indexBuilt, [this, &built]() {
+        index.reset(new GraphIndex(std::move(built)));
+    });
 }
 
+GraphIndex GraphIndex::Build(const IGraph& graph) {
+    GraphIndex result;
+    const std::vector<IGraphNode*>& nodes = graph.GetNodes();
+    int n = nodes.size();
+
+    result.ids.reserve(n);
+    for (int i = 0; i < n; i++) {
+        result.ids[nodes[i]] = i;
+    }
+
+    result.offsets.assign(n + 1, 0);
+    result.reverseOffsets.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        for (const IGraphNode* next : nodes[i]->GetNeighbors()) {
+            int j = result.IdOf(next);
+            // neighbors that were never added to the graph are unreachable
+            if (j < 0) { continue; }
+            result.offsets[i + 1]++;
+            result.reverseOffsets[j + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        result.offsets[i + 1] += result.offsets[i];
+        result.reverseOffsets[i + 1] += result.reverseOffsets[i];
+    }
+
+    result.targets.resize(result.offsets[n]);
+    result.sources.resize(result.reverseOffsets[n]);
+    std::vector<int> reverseFill(result.reverseOffsets.begin(), result.reverseOffsets.end() - 1);
+    for (int i = 0; i < n; i++) {
+        int fill = result.offsets[i];
+        for (const IGraphNode* next : nodes[i]->GetNeighbors()) {
+            int j = result.IdOf(next);
+            if (j < 0) { continue; }
+            result.targets[fill++] = j;
+            result.sources[reverseFill[j]++] = i;
+        }
+    }
+
+    return result;
 }
 
+}
@@ -0,0 +1,88 @@
+#include "graph_factory_registry.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+namespace routing {
+
+GraphFactoryRegistry::~GraphFactoryRegistry() {
+    for (int i = 0; i < factories.size(); i++) {
+        delete factories[i];
+    }
+}
+
+void GraphFactoryRegistry::Register(const IGraphFactory* factory) {
+    factories.push_back(factory);
+
+    std::vector<std::string> extensions = factory->GetExtensions();
+    for (const std::string& ext : extensions) {
+        // first registration wins, like the old trial order
+        byExtension.insert({ext, factory});
+    }
+    if (extensions.empty()) {
+        undeclared.push_back(factory);
+    }
+}
+
+const IGraphFactory* GraphFactoryRegistry::Find(const std::string& file) const {
+    auto found = byExtension.find(Extension(file));
+    if (found != byExtension.end()) {
+        return found->second;
+    }
+
+    std::string header = ReadHeader(file);
+    if (header.empty()) {
+        return NULL;
+    }
+    for (int i = 0; i < factories.size(); i++) {
+        if (factories[i]->MatchesSignature(header)) {
+            return factories[i];
+        }
+    }
+
+    return NULL;
+}
+
+IGraph* GraphFactoryRegistry::Create(const std::string& file) const {
+    const IGraphFactory* factory = Find(file);
+    if (factory) {
+        return factory->Create(file);
+    }
+
+    // factories that cannot describe their files still get a try
+    for (int i = 0; i < undeclared.size(); i++) {
+        IGraph* graph = undeclared[i]->Create(file);
+        if (graph) {
+            return graph;
+        }
+    }
+
+    return NULL;
+}
+
+std::string GraphFactoryRegistry::Extension(const std::string& file) {
+    size_t dot = file.find_last_of('.');
+    size_t slash = file.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return "";
+    }
+
+    std::string ext = file.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+        [](unsigned char c) { return std::tolower(c); });
+    return ext;
+}
+
+std::string GraphFactoryRegistry::ReadHeader(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) {
+        return "";
+    }
+
+    std::string header(kHeaderSize, '\0');
+    in.read(&header[0], kHeaderSize);
+    header.resize(in.gcount());
+    return header;
+}
+
+}
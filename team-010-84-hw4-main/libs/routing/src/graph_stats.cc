@@ -0,0 +1,129 @@
+#include "graph.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+namespace routing {
+
+namespace {
+
+size_t StringBytes(const std::string& s) {
+    // short strings live inside the object
+    size_t inline_capacity = std::string().capacity();
+    return sizeof(std::string) + (s.capacity() > inline_capacity ? s.capacity() + 1 : 0);
+}
+
+int FindRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+}
+
+GraphMemory GraphBase::GetMemoryUsage() const {
+    GraphMemory memory;
+    const std::vector<IGraphNode*>& nodes = GetNodes();
+
+    memory.nodes = sizeof(std::vector<IGraphNode*>) + nodes.capacity() * sizeof(IGraphNode*);
+    for (const IGraphNode* node : nodes) {
+        // the vtable pointer; the members are counted below
+        memory.nodes += sizeof(void*);
+        memory.names += StringBytes(node->GetName());
+        memory.adjacency += sizeof(std::vector<IGraphNode*>) + node->GetNeighbors().capacity() * sizeof(IGraphNode*);
+        memory.positions += sizeof(std::vector<float>) + node->GetPosition().size() * sizeof(float);
+    }
+
+    if (index) {
+        const size_t bucket = sizeof(void*);
+        const size_t entry = sizeof(std::pair<const IGraphNode*, int>) + sizeof(void*);
+        memory.index = sizeof(GraphIndex)
+            + index->ids.bucket_count() * bucket + index->ids.size() * entry
+            + (index->offsets.capacity() + index->targets.capacity()
+                + index->reverseOffsets.capacity() + index->sources.capacity()) * sizeof(int);
+    }
+
+    return memory;
+}
+
+GraphStats GraphBase::GetStats() const {
+    GraphStats stats;
+    const GraphIndex& graph = GetIndex();
+    const int n = graph.NumNodes();
+
+    stats.nodes = n;
+    stats.edges = graph.NumEdges();
+    stats.bounds = GetBoundingBox();
+
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (int i = 0; i < n; i++) {
+        stats.degreeHistogram[graph.OutDegree(i)]++;
+        for (int e = graph.offsets[i]; e < graph.offsets[i+1]; e++) {
+            int a = FindRoot(parent, i);
+            int b = FindRoot(parent, graph.targets[e]);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    std::vector<int> sizes(n, 0);
+    for (int i = 0; i < n; i++) {
+        sizes[FindRoot(parent, i)]++;
+    }
+    for (int size : sizes) {
+        if (size > 0) {
+            stats.componentSizes.push_back(size);
+        }
+    }
+    std::sort(stats.componentSizes.begin(), stats.componentSizes.end(), std::greater<int>());
+
+    // after GetIndex() so the index is included
+    stats.memory = GetMemoryUsage();
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const GraphMemory& memory) {
+    os << "nodes " << memory.nodes
+       << ", names " << memory.names
+       << ", adjacency " << memory.adjacency
+       << ", positions " << memory.positions
+       << ", lookup " << memory.lookup
+       << ", index " << memory.index
+       << ", total " << memory.Total();
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const GraphStats& stats) {
+    os << "nodes: " << stats.nodes << std::endl;
+    os << "edges: " << stats.edges << std::endl;
+
+    os << "degree histogram:";
+    for (auto kv : stats.degreeHistogram) {
+        os << " " << kv.first << ":" << kv.second;
+    }
+    os << std::endl;
+
+    const int shown = 10;
+    os << "components: " << stats.componentSizes.size();
+    if (!stats.componentSizes.empty()) {
+        os << " (sizes";
+        for (int i = 0; i < stats.componentSizes.size() && i < shown; i++) {
+            os << " " << stats.componentSizes[i];
+        }
+        if (stats.componentSizes.size() > shown) {
+            os << " ...";
+        }
+        os << ")";
+    }
+    os << std::endl;
+
+    os << "bounding box: " << stats.bounds << std::endl;
+    os << "memory (bytes): " << stats.memory << std::endl;
+    return os;
+}
+
+}
@@ -1,45 +1,311 @@
 #include "parsers/obj/obj_graph.h"
-#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
 
 namespace routing {
 
-ObjGraph::ObjGraph(const std::string& file) {
-    std::ifstream objFile;
-    objFile.open(file);
-    
-    if (objFile.is_open()) {
-
-        int numNodes = 0;
-        std::string in;
-
-        while (objFile >> in) {
-            if (in == "v") {
-                std::vector<float> pos;
-                float x, y, z;
-                objFile >> x >> y >> z;
-                pos.push_back(x);
-                pos.push_back(z);
-                pos.push_back(-y);
-
-                numNodes++;
-                AddNode(new SimpleGraphNode(std::to_string(numNodes), pos));
+namespace {
+
+// Below this many items the threads cost more than they save.
+const int kMinParallelItems = 1 << 16;
+
+inline bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline const char* SkipBlanks(const char* p, const char* end) {
+    while (p < end && IsBlank(*p)) { p++; }
+    return p;
+}
+
+inline const char* SkipToken(const char* p, const char* end) {
+    while (p < end && !IsBlank(*p) && *p != '\n') { p++; }
+    return p;
+}
+
+inline const char* NextLine(const char* p, const char* end) {
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return newline ? newline + 1 : end;
+}
+
+// [+-]digits. Returns p unchanged if there is no number.
+inline const char* ParseInt(const char* p, const char* end, long& out) {
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p >= end || !IsDigit(*p)) { return start; }
+
+    long value = 0;
+    while (p < end && IsDigit(*p)) {
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    out = negative ? -value : value;
+    return p;
+}
+
+// [+-]digits[.digits][(e|E)[+-]digits], as written by Blender and most other
+// exporters. Returns p unchanged if there is no number.
+inline const char* ParseFloat(const char* p, const char* end, float& out) {
+    static const double kPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    while (p < end && IsDigit(*p)) {
+        if (mantissa < (UINT64_MAX - 9) / 10) {
+            mantissa = mantissa * 10 + (*p - '0');
+        } else {
+            exponent++;
+        }
+        p++;
+        digits++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && IsDigit(*p)) {
+            if (mantissa < (UINT64_MAX - 9) / 10) {
+                mantissa = mantissa * 10 + (*p - '0');
+                exponent--;
             }
+            p++;
+            digits++;
+        }
+    }
+    if (digits == 0) { return start; }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        long e = 0;
+        const char* after = ParseInt(p + 1, end, e);
+        if (after != p + 1) {
+            exponent += e;
+            p = after;
+        }
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0 && -exponent <= 22) {
+        value /= kPowersOfTen[-exponent];
+    } else if (exponent > 0 && exponent <= 22) {
+        value *= kPowersOfTen[exponent];
+    } else if (exponent != 0) {
+        value *= std::pow(10.0, exponent);
+    }
+    out = static_cast<float>(negative ? -value : value);
+    return p;
+}
+
+// Runs work(begin, end) over [0, count) split across the available cores.
+void ParallelFor(int count, const std::function<void(int, int)>& work) {
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, count / kMinParallelItems);
+    if (threads <= 1) {
+        work(0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int chunk = (count + threads - 1) / threads;
+    for (int begin = 0; begin < count; begin += chunk) {
+        workers.emplace_back(work, begin, std::min(count, begin + chunk));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
 
-            if (in == "f") {
-                std::string a, b, c;
-                objFile >> a >> b >> c;
-                AddEdge(a, b);
-                AddEdge(b, a);
-                AddEdge(b, c);
-                AddEdge(c, b);
-                AddEdge(c, a);
-                AddEdge(a, c);
+}
+
+ObjGraph::ObjGraph(const std::string& file) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return;
+    }
+    madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+    const char* begin = static_cast<const char*>(data);
+    std::vector<float> positions;
+    std::vector<std::pair<int, int>> edges;
+    Parse(begin, begin + info.st_size, positions, edges);
+    munmap(data, info.st_size);
+
+    BuildNodes(positions, edges);
+}
+
+const IGraphNode* ObjGraph::GetNode(const std::string& name) const {
+    char* end = NULL;
+    long index = std::strtol(name.c_str(), &end, 10);
+    if (name.empty() || *end != '\0' || index < 1 || index > nodes.size()) {
+        return NULL;
+    }
+    return &nodes[index - 1];
+}
+
+void ObjGraph::Parse(const char* p, const char* end, std::vector<float>& positions, std::vector<std::pair<int, int>>& edges) const {
+    while (p < end) {
+        p = SkipBlanks(p, end);
+        if (end - p < 2 || !IsBlank(p[1])) {
+            p = NextLine(p, end);
+            continue;
+        }
+
+        if (p[0] == 'v') {
+            float x = 0, y = 0, z = 0;
+            p = SkipBlanks(p + 1, end);
+            p = SkipBlanks(ParseFloat(p, end, x), end);
+            p = SkipBlanks(ParseFloat(p, end, y), end);
+            p = ParseFloat(p, end, z);
+            positions.push_back(x);
+            positions.push_back(z);
+            positions.push_back(-y);
+        }
+        else if (p[0] == 'f' || p[0] == 'l') {
+            // faces close back to their first vertex, polylines do not
+            const bool closed = p[0] == 'f';
+            const long vertexCount = positions.size() / 3;
+            int first = -1;
+            int previous = -1;
+            int count = 0;
+            p++;
+            while (true) {
+                p = SkipBlanks(p, end);
+                if (p >= end || *p == '\n') { break; }
+
+                // "a", "a/b", "a//c" or "a/b/c": only the vertex index matters
+                const char* token = p;
+                long index = 0;
+                const char* after = ParseInt(token, end, index);
+                p = SkipToken(after, end);
+                if (after == token) { continue; }
+
+                int current = index > 0 ? index - 1 : (index < 0 ? vertexCount + index : -1);
+                if (previous >= 0 && current >= 0) {
+                    edges.push_back({previous, current});
+                }
+                if (count == 0) { first = current; }
+                previous = current;
+                count++;
+            }
+            if (closed && count > 2 && first >= 0 && previous >= 0) {
+                edges.push_back({previous, first});
             }
         }
-        
 
-        objFile.close();
+        p = NextLine(p, end);
+    }
+}
+
+void ObjGraph::BuildNodes(const std::vector<float>& positions, const std::vector<std::pair<int, int>>& edges) {
+    const int n = positions.size() / 3;
+
+    // scatter both directions of every edge into per-node slices
+    std::vector<int> offsets(n + 1, 0);
+    for (const auto& edge : edges) {
+        if (edge.first == edge.second || edge.first < 0 || edge.second < 0 || edge.first >= n || edge.second >= n) {
+            continue;
+        }
+        offsets[edge.first + 1]++;
+        offsets[edge.second + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
     }
+    std::vector<int> targets(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& edge : edges) {
+        if (edge.first == edge.second || edge.first < 0 || edge.second < 0 || edge.first >= n || edge.second >= n) {
+            continue;
+        }
+        targets[fill[edge.first]++] = edge.second;
+        targets[fill[edge.second]++] = edge.first;
+    }
+
+    // sort and de-duplicate each slice, so an edge shared by several faces
+    // is relaxed once
+    std::vector<int> degree(n);
+    ParallelFor(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            int* first = targets.data() + offsets[i];
+            int* last = targets.data() + offsets[i + 1];
+            std::sort(first, last);
+            degree[i] = std::unique(first, last) - first;
+        }
+    });
+
+    GraphIndex index;
+    index.offsets.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        index.offsets[i + 1] = index.offsets[i] + degree[i];
+    }
+    index.targets.resize(index.offsets[n]);
+    ParallelFor(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            std::copy(targets.begin() + offsets[i], targets.begin() + offsets[i] + degree[i],
+                index.targets.begin() + index.offsets[i]);
+        }
+    });
+    std::vector<int>().swap(targets);
+
+    nodes.reserve(n);
+    nodePointers.reserve(n);
+    for (int i = 0; i < n; i++) {
+        nodes.emplace_back(std::to_string(i + 1), std::vector<float>(positions.begin() + 3 * i, positions.begin() + 3 * i + 3));
+        nodePointers.push_back(&nodes.back());
+    }
+    index.ids.reserve(n);
+    for (int i = 0; i < n; i++) {
+        ObjGraphNode& node = nodes[i];
+        node.neighbors.reserve(degree[i]);
+        for (int e = index.offsets[i]; e < index.offsets[i + 1]; e++) {
+            node.neighbors.push_back(&nodes[index.targets[e]]);
+        }
+        index.ids[&node] = i;
+    }
+
+    // every edge runs both ways, so predecessors are the successors
+    index.reverseOffsets = index.offsets;
+    index.sources = index.targets;
+    AdoptIndex(std::move(index));
 }
 
 }
@@ -61,6 +61,22 @@ const OSMNode* OSMGraph::NodeNamed(const string name) const {
     return node_named(name);
 };
 
+GraphMemory OSMGraph::GetMemoryUsage() const {
+    GraphMemory memory = GraphBase::GetMemoryUsage();
+    // positions are an inline Point3 rather than a vector
+    memory.positions = nodes_.size() * sizeof(Point3);
+
+    size_t inline_capacity = string().capacity();
+    memory.lookup = lookup_.bucket_count() * sizeof(void*);
+    for (const auto& kv : lookup_) {
+        memory.lookup += sizeof(std::pair<const string, OSMNode*>) + sizeof(void*);
+        if (kv.first.capacity() > inline_capacity) {
+            memory.lookup += kv.first.capacity() + 1;
+        }
+    }
+    return memory;
+};
+
 bool OSMGraph::Contains(const string name) const {
     return !(lookup_.find(name) == lookup_.end());
 };
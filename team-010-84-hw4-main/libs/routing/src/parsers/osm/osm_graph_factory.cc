@@ -6,11 +6,16 @@
 namespace routing {
 
 IGraph* OSMGraphFactory::Create(const std::string& file) const {
-	if (file.substr(file.size()-4) != ".osm") {
-		return NULL;
-	}
-
 	return OsmParser::LoadGraphFromFile(file, false);
 }
 
-}
\ No newline at end of file
+bool OSMGraphFactory::MatchesSignature(const std::string& header) const {
+	// an XML document whose root element is <osm ...>
+	size_t start = header.find_first_not_of(" \t\r\n\xEF\xBB\xBF");
+	if (start == std::string::npos || header[start] != '<') {
+		return false;
+	}
+	return header.find("<osm", start) != std::string::npos;
+}
+
+}
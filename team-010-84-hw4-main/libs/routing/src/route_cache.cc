@@ -0,0 +1,53 @@
+#include "route_cache.h"
+
+#include <functional>
+
+namespace routing {
+
+size_t RouteCache::KeyHash::operator()(const Key& key) const {
+    std::hash<const void*> hash;
+    size_t h = hash(key.strategy);
+    h = h * 31 + hash(key.from);
+    h = h * 31 + hash(key.to);
+    return h;
+}
+
+RouteCache::RouteCache(size_t capacity)
+    : shardCapacity(capacity / kShards + 1), hitCount(0), missCount(0) {}
+
+RouteCache::Shard& RouteCache::ShardOf(const Key& key) const {
+    // the low bits of pointer hashes are mostly alignment, so mix first
+    size_t h = KeyHash()(key);
+    h ^= h >> 17;
+    return shards[(h * 0x9E3779B97F4A7C15ull) >> 60 & (kShards - 1)];
+}
+
+std::shared_ptr<const WaypointBuffer> RouteCache::Find(const RoutingStrategy* strategy, const IGraphNode* from, const IGraphNode* to) const {
+    Key key = {strategy, from, to};
+    Shard& shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.paths.find(key);
+    if (it == shard.paths.end()) {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+    hitCount.fetch_add(1, std::memory_order_relaxed);
+    return it->second;
+}
+
+void RouteCache::Insert(const RoutingStrategy* strategy, const IGraphNode* from, const IGraphNode* to, std::shared_ptr<const WaypointBuffer> path) {
+    Key key = {strategy, from, to};
+    Shard& shard = ShardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // another thread may have searched the same route meanwhile
+    if (!shard.paths.emplace(key, path).second) {
+        return;
+    }
+    shard.order.push_back(key);
+    if (shard.order.size() > shardCapacity) {
+        shard.paths.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+}
@@ -2,6 +2,8 @@
 #include "routing/depth_first_search.h"
 #include "routing/breadth_first_search.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 #include <unordered_set>
 #include <queue>
@@ -60,7 +62,9 @@ bool compareCandidatePaths(const CandidatePath* path1, const CandidatePath* path
     return (path1->distance + path1->estimate) > (path2->distance + path2->estimate);
 };
 
-vector<string> AStar::GetPath(const IGraph* graph, const std::string& from, const std::string& to) const {
+vector<string> AStar::GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const {
+    QueryStats unused;
+    QueryStats& counters = stats ? *stats : unused;
 
     const IGraphNode* start_node = graph->GetNode(from);
     // only here for debugging
@@ -85,10 +89,13 @@ vector<string> AStar::GetPath(const IGraph* graph, const std::string& from, cons
             new FStack<string>(from),
             0
         ));
+    counters.heapPushes++;
+    counters.peakFrontier = 1;
 
     while (!possible_paths.empty()) {
         CandidatePath* candidate = possible_paths.top();
         possible_paths.pop();
+        counters.heapPops++;
 
         // TODO
         /*
@@ -122,6 +129,7 @@ vector<string> AStar::GetPath(const IGraph* graph, const std::string& from, cons
         // std::cerr << "at: " << path_end << std::endl;
         if (visited.find(path_end) == visited.end()) {
             visited.insert(path_end);
+            counters.nodesSettled++;
 
             if(path_end == to) {
                 // we found our result
@@ -148,16 +156,38 @@ vector<string> AStar::GetPath(const IGraph* graph, const std::string& from, cons
                         candidate->distance + cost->Calculate(path_end_node->GetPosition(), next->GetPosition()),
                         heuristic->Calculate(next->GetPosition(), terminal_node->GetPosition())
                     ));
+                counters.edgesRelaxed++;
+                counters.heapPushes++;
             }
+            counters.peakFrontier = std::max<long>(counters.peakFrontier, possible_paths.size());
         }
     }
     return {};
 }
 
-std::vector<std::string> BreadthFirstSearch::GetPath(const IGraph* graph, const std::string& from, const std::string& to) const {
-    unordered_set<string> visited; // don't check nodes we've already visited
-    queue<CandidatePath*> possible_paths; // queue of all paths we're considering in BFS
+// Fixed size set of node ids, one bit per node.
+class Bitmap {
+    public:
+        Bitmap(int size) : words((size + 63) / 64, 0) { };
+
+        bool Test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; };
+        void Set(int i) { words[i >> 6] |= uint64_t(1) << (i & 63); };
+        void Reset(int i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); };
+
+    private:
+        vector<uint64_t> words;
+};
+
+// Tuning from Beamer et al., "Direction-Optimizing Breadth-First Search".
+// Go bottom-up once the frontier's out edges exceed 1/kAlpha of the edges
+// left to explore, and back top-down once the frontier holds fewer than
+// 1/kBeta of the nodes.
+static const long kAlpha = 14;
+static const long kBeta = 24;
 
+std::vector<std::string> BreadthFirstSearch::GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const {
+    QueryStats unused;
+    QueryStats& counters = stats ? *stats : unused;
     const IGraphNode* start_node = graph->GetNode(from);
     // only here for debugging
     if(!start_node) {
@@ -169,56 +199,99 @@ std::vector<std::string> BreadthFirstSearch::GetPath(const IGraph* graph, const
         throw invalid_argument("'to' node not found in graph: " + to);
     }
 
-    visited.insert(from);
-    possible_paths.push(
-        new CandidatePath(
-            new FStack<string>(from),
-            0
-        ));
-
-    while(!possible_paths.empty()) {
-        auto* path = possible_paths.front();
-        possible_paths.pop();
-
-        const string path_end = path->path->Top();
-        // was checked to be in the graph when we added it
-        // so no need to check
+    const GraphIndex& index = graph->GetIndex();
+    const int source = index.IdOf(start_node);
+    const int target = index.IdOf(terminal_node);
+    if (source < 0 || target < 0) {
+        return {};
+    }
+    if (source == target) {
+        return {from};
+    }
 
-        const IGraphNode* path_end_node = graph->GetNode(path_end);
-        if (!path_end_node) {
-            std::cerr << "Encountered node not in graph, named: ";
-            std::cerr << path_end << std::endl;
-            std::cerr << "Ignoring and continuing" << std::endl;
-            continue;
+    const int n = index.NumNodes();
+    vector<int> parent(n, -1);
+    Bitmap visited(n);
+    Bitmap in_frontier(n);
+    vector<int> frontier = {source};
+    vector<int> next;
+    parent[source] = source;
+    visited.Set(source);
+
+    long unexplored_edges = index.NumEdges();
+    long frontier_edges = index.OutDegree(source);
+    bool bottom_up = false;
+
+    counters.heapPushes = 1;
+    counters.peakFrontier = 1;
+    while (!frontier.empty() && !visited.Test(target)) {
+        // a level is settled as a whole, so a node counts when it is expanded
+        counters.nodesSettled += frontier.size();
+        counters.heapPops += frontier.size();
+        if (!bottom_up && frontier_edges > unexplored_edges / kAlpha) {
+            bottom_up = true;
+        } else if (bottom_up && static_cast<long>(frontier.size()) < n / kBeta) {
+            bottom_up = false;
         }
-
-        const vector<IGraphNode*> next_steps = path_end_node->GetNeighbors();
-        for(IGraphNode* next : next_steps) {
-            const string next_name = next->GetName();
-            if(next_name == to) {
-                // we found our goal
-                vector<string> result = *path->path->ToList();
-                result.push_back(next_name);
-                // NOTE: This currently makes a large memory leak
-                // B/C None of the candidate paths, nor their FStack's are freed
-                // Not sure how to free the FStacks.
-                return result;
-            } // implicit else
-
-
-            if(visited.find(next_name) == visited.end()) {
-                // we haven't been to this node yet
-                visited.insert(next_name);
-                possible_paths.push(
-                    new CandidatePath(
-                        path->path->Push(next_name)));
+        unexplored_edges -= frontier_edges;
+        frontier_edges = 0;
+        next.clear();
+
+        if (bottom_up) {
+            // every unvisited node looks for any parent in the frontier
+            for (int u : frontier) { in_frontier.Set(u); }
+            for (int v = 0; v < n; v++) {
+                if (visited.Test(v)) { continue; }
+                for (int e = index.reverseOffsets[v]; e < index.reverseOffsets[v+1]; e++) {
+                    int u = index.sources[e];
+                    counters.edgesRelaxed++;
+                    if (in_frontier.Test(u)) {
+                        parent[v] = u;
+                        visited.Set(v);
+                        next.push_back(v);
+                        frontier_edges += index.OutDegree(v);
+                        break;
+                    }
+                }
+            }
+            for (int u : frontier) { in_frontier.Reset(u); }
+        } else {
+            // every frontier node claims its unvisited successors
+            for (int u : frontier) {
+                for (int e = index.offsets[u]; e < index.offsets[u+1]; e++) {
+                    int v = index.targets[e];
+                    counters.edgesRelaxed++;
+                    if (!visited.Test(v)) {
+                        parent[v] = u;
+                        visited.Set(v);
+                        next.push_back(v);
+                        frontier_edges += index.OutDegree(v);
+                    }
+                }
             }
         }
+        counters.heapPushes += next.size();
+        counters.peakFrontier = std::max<long>(counters.peakFrontier, next.size());
+        frontier.swap(next);
     }
-    return {};
+
+    if (!visited.Test(target)) {
+        return {};
+    }
+
+    const vector<IGraphNode*>& nodes = graph->GetNodes();
+    vector<string> result;
+    for (int v = target; v != source; v = parent[v]) {
+        result.push_back(nodes[v]->GetName());
+    }
+    result.push_back(from);
+    std::reverse(result.begin(), result.end());
+    return result;
 }
 
-std::vector<std::string> DepthFirstSearch::GetPath(const IGraph* graph, const std::string& from, const std::string& to) const {
+std::vector<std::string> DepthFirstSearch::GetPath(const IGraph* graph, const std::string& from, const std::string& to, QueryStats* stats) const {
+    QueryStats unused;
+    QueryStats& counters = stats ? *stats : unused;
     unordered_set<string> visited; // don't check nodes we've already visited
     vector<CandidatePath*> possible_paths; // stack of all paths we're considering in DFS
 
@@ -239,10 +312,14 @@ std::vector<std::string> DepthFirstSearch::GetPath(const IGraph* graph, const st
             new FStack<string>(from),
             0
         ));
+    counters.heapPushes++;
+    counters.peakFrontier = 1;
 
     while(!possible_paths.empty()) {
         auto* path = possible_paths.back();
         possible_paths.pop_back();
+        counters.heapPops++;
+        counters.nodesSettled++;
 
         const string path_end = path->path->Top();
         // was checked to be in the graph when we added it
@@ -259,6 +336,7 @@ std::vector<std::string> DepthFirstSearch::GetPath(const IGraph* graph, const st
         const vector<IGraphNode*> next_steps = path_end_node->GetNeighbors();
         for(IGraphNode* next : next_steps) {
             const string next_name = next->GetName();
+            counters.edgesRelaxed++;
             if(next_name == to) {
                 // we found our goal
                 vector<string> result = *path->path->ToList();
@@ -276,8 +354,10 @@ std::vector<std::string> DepthFirstSearch::GetPath(const IGraph* graph, const st
                 possible_paths.push_back(
                     new CandidatePath(
                         path->path->Push(next_name)));
+                counters.heapPushes++;
             }
         }
+        counters.peakFrontier = std::max<long>(counters.peakFrontier, possible_paths.size());
     }
     return {};
 }
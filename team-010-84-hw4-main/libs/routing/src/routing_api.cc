@@ -4,30 +4,26 @@
 
 namespace routing {
 
-RoutingAPI::RoutingAPI() {
-    factories.push_back(new OSMGraphFactory());
-    factories.push_back(new ObjGraphFactory());
+RoutingAPI::RoutingAPI() : factories(new GraphFactoryRegistry()) {
+    factories->Register(new OSMGraphFactory());
+    factories->Register(new ObjGraphFactory());
 }
 
-RoutingAPI::~RoutingAPI() {
-    for (int i = 0; i < factories.size(); i++) {
-        delete factories[i];
-    }
-}
+RoutingAPI::~RoutingAPI() {}
 
 IGraph* RoutingAPI::LoadFromFile(const std::string& file) const {
-    for (int i = 0; i < factories.size(); i++) {
-        IGraph* graph = factories[i]->Create(file);
-        if (graph) {
-            return graph;
-        }
-    }
+    return factories->Create(file);
+}
 
-    return NULL;
+std::future<IGraph*> RoutingAPI::PreloadFromFile(const std::string& file) const {
+    std::shared_ptr<GraphFactoryRegistry> registry = factories;
+    return std::async(std::launch::async, [registry, file]() {
+        return registry->Create(file);
+    });
 }
 
 void RoutingAPI::AddFactory(const IGraphFactory* factory) {
-    factories.push_back(factory);
+    factories->Register(factory);
 }
 
-}
\ No newline at end of file
+}
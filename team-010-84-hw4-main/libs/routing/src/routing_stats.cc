@@ -0,0 +1,111 @@
+#include "routing_stats.h"
+
+namespace routing {
+
+Histogram::Histogram() : count(0), sum(0) {
+    for (int i = 0; i < kBuckets; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::Record(uint64_t value) {
+    int bucket = 0;
+    while (value >> bucket && bucket < kBuckets - 1) {
+        bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> Histogram::GetBuckets() const {
+    std::vector<uint64_t> result(kBuckets);
+    for (int i = 0; i < kBuckets; i++) {
+        result[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+uint64_t Histogram::Quantile(double q) const {
+    std::vector<uint64_t> counts = GetBuckets();
+    uint64_t total = 0;
+    for (uint64_t c : counts) {
+        total += c;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = q * total;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; i++) {
+        seen += counts[i];
+        if (seen > rank) {
+            return i == 0 ? 0 : (uint64_t(1) << i) - 1;
+        }
+    }
+    return (uint64_t(1) << (kBuckets - 1)) - 1;
+}
+
+RoutingMetrics::RoutingMetrics()
+    : queryCount(0), failureCount(0), cacheHitCount(0), nodesSettledTotal(0), edgesRelaxedTotal(0),
+      heapPushesTotal(0), heapPopsTotal(0), peakFrontierMax(0) {}
+
+RoutingMetrics& RoutingMetrics::Global() {
+    static RoutingMetrics metrics;
+    return metrics;
+}
+
+void RoutingMetrics::Record(const QueryStats& stats) {
+    queryCount.fetch_add(1, std::memory_order_relaxed);
+    if (!stats.found) {
+        failureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (stats.cached) {
+        cacheHitCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    nodesSettledTotal.fetch_add(stats.nodesSettled, std::memory_order_relaxed);
+    edgesRelaxedTotal.fetch_add(stats.edgesRelaxed, std::memory_order_relaxed);
+    heapPushesTotal.fetch_add(stats.heapPushes, std::memory_order_relaxed);
+    heapPopsTotal.fetch_add(stats.heapPops, std::memory_order_relaxed);
+
+    uint64_t peak = peakFrontierMax.load(std::memory_order_relaxed);
+    uint64_t frontier = stats.peakFrontier;
+    while (frontier > peak &&
+        !peakFrontierMax.compare_exchange_weak(peak, frontier, std::memory_order_relaxed)) {
+    }
+
+    totalMicros.Record(stats.totalSeconds * 1e6);
+    snapMicros.Record(stats.snapSeconds * 1e6);
+    settledPerQuery.Record(stats.nodesSettled);
+}
+
+std::ostream& operator<<(std::ostream& os, const QueryStats& stats) {
+    os << "settled " << stats.nodesSettled
+       << ", relaxed " << stats.edgesRelaxed
+       << ", pushes " << stats.heapPushes
+       << ", pops " << stats.heapPops
+       << ", peak frontier " << stats.peakFrontier
+       << ", snap " << stats.snapSeconds * 1e3 << "ms"
+       << ", search " << stats.searchSeconds * 1e3 << "ms"
+       << ", total " << stats.totalSeconds * 1e3 << "ms"
+       << (stats.found ? "" : " (no path)")
+       << (stats.cached ? " (cached)" : "");
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const RoutingMetrics& metrics) {
+    os << "queries: " << metrics.queries() << " (" << metrics.failures() << " without a path)" << std::endl;
+    os << "answered from cache: " << metrics.cacheHits() << std::endl;
+    os << "nodes settled: " << metrics.nodesSettled() << std::endl;
+    os << "edges relaxed: " << metrics.edgesRelaxed() << std::endl;
+    os << "heap pushes/pops: " << metrics.heapPushes() << "/" << metrics.heapPops() << std::endl;
+    os << "peak frontier: " << metrics.peakFrontier() << std::endl;
+    os << "query time p50/p99 (us): <=" << metrics.totalTime().Quantile(0.5)
+       << " / <=" << metrics.totalTime().Quantile(0.99) << std::endl;
+    os << "snap time p50/p99 (us): <=" << metrics.snapTime().Quantile(0.5)
+       << " / <=" << metrics.snapTime().Quantile(0.99) << std::endl;
+    return os;
+}
+
+}
@@ -0,0 +1,35 @@
+#include "waypoint_buffer.h"
+
+#include <cmath>
+
+namespace routing {
+
+WaypointBuffer::WaypointBuffer(const std::vector< std::vector<float> >& path) {
+    points.reserve(path.size());
+    for (const std::vector<float>& position : path) {
+        Append(position);
+    }
+}
+
+void WaypointBuffer::Append(float x, float y, float z) {
+    float distance = 0;
+    if (!points.empty()) {
+        const Waypoint& last = points.back();
+        float dx = x - last.x;
+        float dy = y - last.y;
+        float dz = z - last.z;
+        distance = last.distance + std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+    points.push_back({x, y, z, distance});
+}
+
+std::vector< std::vector<float> > WaypointBuffer::ToVectors() const {
+    std::vector< std::vector<float> > path;
+    path.reserve(points.size());
+    for (const Waypoint& point : points) {
+        path.push_back({point.x, point.y, point.z});
+    }
+    return path;
+}
+
+}
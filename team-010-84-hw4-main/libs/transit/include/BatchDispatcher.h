@@ -0,0 +1,37 @@
+#ifndef BATCH_DISPATCHER_H_
+#define BATCH_DISPATCHER_H_
+
+#include "IDispatcher.h"
+
+/**
+ * @class BatchDispatcher
+ * @brief Assigns a batch of pending packages to available drones at once,
+ * minimizing their total delivery time. Each package only considers the few
+ * nearest drones that can carry it, and the resulting sparse
+ * package-by-drone problem is solved exactly with the Hungarian method.
+ * Only the oldest packages are batched, so none waits behind ever newer
+ * ones. Drones that would first have to recharge are used only when
+ * nothing better is left.
+ */
+class BatchDispatcher : public IDispatcher {
+ public:
+  /**
+   * @brief Constructor
+   * @param candidatesPerPackage Nearest drones each package considers
+   * @param cellSize Cell size of the grid used to find them
+   */
+  BatchDispatcher(int candidatesPerPackage = 8, double cellSize = 200);
+
+  /**
+   * @brief Assigns the oldest pending deliveries in one batch
+   * @param model Model whose available drones and charging stations to use
+   * @param pending Packages waiting for a drone, oldest first
+   */
+  void dispatch(SimulationModel& model, std::deque<Package*>& pending);
+
+ private:
+  int candidatesPerPackage;
+  double cellSize;
+};
+
+#endif
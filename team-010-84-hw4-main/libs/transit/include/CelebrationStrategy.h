@@ -0,0 +1,123 @@
+#ifndef CELEBRATION_STRATEGY_H_
+#define CELEBRATION_STRATEGY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "PathStrategy.h"
+
+/**
+ * @brief Base for celebrations, such as spinning or jumping, that an entity
+ * performs for a while once it arrives. Derived classes provide
+ * act(entity, dt); this class keeps track of how long is left.
+ *
+ * @tparam Derived The celebration itself
+ */
+template <class Derived>
+class Celebration {
+ public:
+  /**
+   * @brief Construct a new Celebration object
+   *
+   * @param[in] time how long to celebrate
+   */
+  explicit Celebration(double time) : time(time) {}
+
+  /**
+   * @brief Celebrate for dt, or for as long as is left if that is less.
+   *
+   * @param entity Entity to celebrate
+   * @param dt Delta Time
+   * @return The part of dt left over once the celebration is over
+   */
+  double celebrate(IEntity* entity, double dt) {
+    double celebrating = std::min<double>(dt, time);
+    static_cast<Derived*>(this)->act(entity, celebrating);
+    time -= celebrating;
+    return dt - celebrating;
+  }
+
+  /**
+   * @brief Check if the celebration is over
+   *
+   * @return True if complete, false if not complete
+   */
+  bool isCompleted() const { return time <= 0; }
+
+ private:
+  float time;
+};
+
+/**
+ * @brief this class inherits from the PathStrategy class and represents a
+ * movement strategy where the entity follows a path and then performs each
+ * of its celebrations in turn, in the order they are listed. The path and
+ * every celebration live in this one object and are called directly, so
+ * decorating a path costs no extra allocations or virtual calls.
+ *
+ * @tparam Celebrations The celebrations to perform, each a Celebration
+ */
+template <class... Celebrations>
+class CelebrationStrategy : public PathStrategy {
+ public:
+  /**
+   * @brief Construct a new Celebration Strategy object
+   *
+   * @param[in] path the strategy whose path to follow. Route strategies
+   * only choose the path, so it is taken over as a plain PathStrategy.
+   * @param[in] celebrations what to do on arrival
+   */
+  explicit CelebrationStrategy(PathStrategy&& path,
+                               Celebrations... celebrations)
+      : PathStrategy(std::move(path)),
+        celebrations(std::move(celebrations)...) {}
+
+  /**
+   * @brief Move along the path, then celebrate, carrying whatever time one
+   * phase leaves over into the next.
+   *
+   * @param entity Entity to move
+   * @param dt Delta Time
+   * @return The time left over once every celebration is over
+   */
+  double move(IEntity* entity, double dt) override {
+    if (!PathStrategy::isCompleted()) dt = PathStrategy::move(entity, dt);
+    while (dt > 0 && phase < sizeof...(Celebrations)) {
+      dt = celebrate(entity, dt);
+    }
+    return dt;
+  }
+
+  /**
+   * @brief Check if the path has been followed and every celebration is
+   * over
+   *
+   * @return True if complete, false if not complete
+   */
+  bool isCompleted() override {
+    return phase == sizeof...(Celebrations) && PathStrategy::isCompleted();
+  }
+
+ private:
+  std::tuple<Celebrations...> celebrations;
+  std::size_t phase = 0;  // the celebration under way
+
+  // Runs the current celebration, found at compile time from its index,
+  // and returns the time it left over.
+  template <std::size_t I = 0>
+  double celebrate(IEntity* entity, double dt) {
+    if constexpr (I < sizeof...(Celebrations)) {
+      if (phase != I) return celebrate<I + 1>(entity, dt);
+      auto& celebration = std::get<I>(celebrations);
+      dt = celebration.celebrate(entity, dt);
+      if (celebration.isCompleted()) phase++;
+      return dt;
+    } else {
+      return dt;
+    }
+  }
+};
+
+#endif  // CELEBRATION_STRATEGY_H_
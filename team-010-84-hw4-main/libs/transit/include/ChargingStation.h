@@ -2,16 +2,30 @@
 #define CHARGING_STATION_H_
 
 
-#include <vector>
+#include <deque>
+#include <functional>
 #include <queue>
+#include <utility>
+#include <vector>
 
 
 #include "Drone.h"
 
+/**
+ * @brief Charging a station has been promised but not yet told of, such as
+ * by deliveries a dispatcher is still matching to drones
+ **/
+struct StationLoad {
+  int drones = 0;
+  double deficit = 0;
+};
+
 /**
  * @class ChargingStation 
  * @brief In charge of recharging the battery
- * of the drones
+ * of the drones. A drone's charge rises steadily once it is plugged in, so
+ * the station works out when each drone will be full as it plugs in and
+ * sleeps until then; drones read their charge off the clock in between.
  **/
 class ChargingStation : public IEntity {
  public:
@@ -30,14 +44,31 @@ class ChargingStation : public IEntity {
 
 
     /**
-     * @brief If there is space at the charging station, decrements drone queue
-     * and adds drone to charging station
+     * @brief Unplugs the drones that are full by now and plugs in queued
+     * drones in their place. The model wakes the station when the next
+     * drone is due to be full.
      *
      * @param dt delta time
      **/
     void update(double dt);
 
 
+    /**
+     * @brief Gets the kind of the entity
+     * @return EntityKind::ChargingStation
+     */
+    EntityKind getKind() const { return EntityKind::ChargingStation; }
+
+
+    /**
+     * @brief A station is always idle between the times drones are due to
+     * be full
+     *
+     * @return true
+     **/
+    bool isIdle() const { return true; }
+
+
     /**
      * @brief Removing the copy constructor operator
      * so that charging stations cannot be copied.
@@ -58,7 +89,8 @@ class ChargingStation : public IEntity {
 
     /**
      * @brief Once drone arrives at charging station, queueUp is used
-     * to add drone to queue of drones to be charged
+     * to add drone to queue of drones to be charged. It plugs in at once if
+     * a slot is free.
      *
      * @param drone Drone to be charged
      **/
@@ -66,13 +98,29 @@ class ChargingStation : public IEntity {
 
 
     /**
-     * @brief Function that recharges drone
+     * @brief Tells the station a drone is on its way, so it counts toward
+     * the wait until the drone queues up
+     *
+     * @param drone Drone that will queue up here
+     * @param deficit Charge the drone will be short of full on arrival
      **/
-    void rechargeDrone(double dt);
+    void expect(Drone* drone, double deficit);
 
 
     /**
-     * @brief Unplugs drone once charging is completed
+     * @brief Estimates how long a drone arriving now would wait for a slot,
+     * assuming the slots share out the charging owed to the drones plugged
+     * in, queued and on their way
+     *
+     * @param extra Further drones expected on top of those
+     * @return Seconds until a slot frees, 0 if one is free
+     **/
+    double estimatedWait(const StationLoad& extra = StationLoad()) const;
+
+
+    /**
+     * @brief Unplugs a drone, or takes it out of the queue, when it leaves
+     * before it is full
      *
      * @param drone Drone to be unplugged
      **/
@@ -80,10 +128,23 @@ class ChargingStation : public IEntity {
 
 
  private:
-    int slotsAvailible;
+    void plugIn(Drone* drone, int slot);
+    void unplug(int slot);
+    void admit();
+
     int chargeRate;
-    std::queue<Drone*> droneQueue;
+    std::deque<Drone*> droneQueue;
     std::vector<Drone*> droneCurCharge;
+    std::vector<int> freeSlots;
+    // when the drone in each slot will be full
+    std::vector<double> fullAt;
+    // (time, slot) of every drone still to be full, soonest first; drones
+    // unplugged early leave stale entries, told apart by fullAt
+    typedef std::pair<double, int> Completion;
+    std::priority_queue<Completion, std::vector<Completion>,
+                        std::greater<Completion>> completions;
+    // drones on their way, with the charge each will be short of
+    std::vector<std::pair<Drone*, double>> inbound;
 };
 
 
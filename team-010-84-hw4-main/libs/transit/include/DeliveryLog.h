@@ -0,0 +1,78 @@
+#ifndef DELIVERY_LOG_H_
+#define DELIVERY_LOG_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "util/json.h"
+
+/**
+ * @brief Simulated times at which one delivery reached each stage, or -1
+ * if it has not yet
+ */
+struct DeliveryRecord {
+  int package = -1;
+  std::string name;
+  double scheduled = -1;
+  double assigned = -1;
+  double delivered = -1;
+};
+
+/**
+ * @class DeliveryLog
+ * @brief Records when each delivery was scheduled, given a drone and
+ * handed to its robot, and summarizes them as key performance indicators
+ */
+class DeliveryLog {
+ public:
+  /**
+   * @brief Records a newly scheduled delivery
+   * @param package Id of the package
+   * @param name Name of the package
+   * @param time Simulated time
+   */
+  void scheduled(int package, const std::string& name, double time);
+
+  /**
+   * @brief Records that a drone took the delivery
+   * @param package Id of the package
+   * @param time Simulated time
+   */
+  void assigned(int package, double time);
+
+  /**
+   * @brief Records that the package reached its robot
+   * @param package Id of the package
+   * @param time Simulated time
+   */
+  void delivered(int package, double time);
+
+  /**
+   * @return Every delivery, in the order they were scheduled
+   */
+  const std::vector<DeliveryRecord>& getRecords() const { return records; }
+
+  /**
+   * @return Number of scheduled deliveries not yet handed over
+   */
+  int outstanding() const { return records.size() - deliveredCount; }
+
+  /**
+   * @brief Summarizes the deliveries
+   * @param time Simulated time the summary is taken at, for throughput
+   * @return {scheduled, assigned, delivered, outstanding, perHour,
+   * waitForDrone, latency}, where the last two hold {mean, p50, p95, max}
+   * in simulated seconds
+   */
+  JsonObject summary(double time) const;
+
+ private:
+  DeliveryRecord* find(int package);
+
+  std::vector<DeliveryRecord> records;
+  std::unordered_map<int, int> recordOf;
+  int deliveredCount = 0;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef DRONE_H_
 #define DRONE_H_
 
+#include <memory>
 #include <vector>
 
 #include "IEntity.h"
@@ -49,6 +50,19 @@ class Drone : public IEntity {
    */
   void update(double dt);
 
+  /**
+   * @brief Gets the kind of the entity
+   * @return EntityKind::Drone
+   */
+  EntityKind getKind() const { return EntityKind::Drone; }
+
+  /**
+   * @brief A drone is idle once parked with no trip ahead of it; its
+   * station charges it, and a new delivery wakes it.
+   * @return Whether the drone is parked
+   */
+  bool isIdle() const;
+
   /**
    * @brief Removing the copy constructor operator
    * so that drones cannot be copied.
@@ -66,10 +80,17 @@ class Drone : public IEntity {
   Drone& operator=(const Drone& drone) = delete;
 
   /**
-   * @brief Recharge the battery by the given amount
-   * @param amount the amount to charge the battery by
+   * @brief Starts charging the battery at a steady rate. The charge is
+   * worked out from the clock when read, so nothing needs to update it.
+   * @param rate Charge gained per simulated second
+   */
+  void startCharging(double rate);
+
+  /**
+   * @brief Stops charging, keeping the charge gained so far. Does nothing
+   * if the drone is not charging.
    */
-  void recharge(const double amount);
+  void stopCharging();
 
   /**
    * @brief Indicates whether the drone is available or not
@@ -86,7 +107,8 @@ class Drone : public IEntity {
 
   /**
    * @brief Indicates the drone current charge
-   * @return integer value representing the current battery charge of the drone
+   * @return the current battery charge of the drone, counting what it has
+   * gained since it started charging
    */
   double getBatteryCharge();
 
@@ -100,11 +122,14 @@ class Drone : public IEntity {
   bool available = false;
   bool pickedUp = false;
   Package* package = nullptr;
-  IStrategy* toPackage = nullptr;
-  IStrategy* toFinalDestination = nullptr;
-  IStrategy* rechargeStation = nullptr;
+  std::unique_ptr<IStrategy> toPackage;
+  std::unique_ptr<IStrategy> toFinalDestination;
+  std::unique_ptr<IStrategy> rechargeStation;
   ChargingStation* nextChargingStation = nullptr;
-  double batteryCharge = 0;
+  ChargingStation* dockedAt = nullptr;  // the station it queued up at
+  double batteryCharge = 0;  // as of chargingSince while charging
+  double chargeRate = 0;      // 0 while not charging
+  double chargingSince = 0;
   int weightCapacity = 0;
   int batteryCapacity = 0;
   double chargeRequired = 0.0;  // charger required to start moving to package
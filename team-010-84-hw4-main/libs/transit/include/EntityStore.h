@@ -0,0 +1,232 @@
+#ifndef ENTITY_STORE_H_
+#define ENTITY_STORE_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ChargingStation.h"
+#include "Drone.h"
+#include "IEntity.h"
+#include "Package.h"
+#include "Robot.h"
+
+/**
+ * @brief Stable reference to an entity in an EntityStore. A handle goes
+ * stale, rather than pointing at a different entity, once its entity is
+ * removed.
+ */
+struct EntityHandle {
+  int index = -1;
+  int generation = 0;
+};
+
+/**
+ * @class EntityStore
+ * @brief Owns no entities, but files each one by kind into a dense array so
+ * a system can walk just the drones, packages, robots or stations it cares
+ * about. Lookup by handle or id and removal are O(1); removal swaps the last
+ * entity of the same kind into the hole, so order within a kind is not
+ * preserved.
+ *
+ * The store also keeps secondary indexes by name, by open delivery request
+ * and by available drone weight class. Names and the request flags are read
+ * when an entity is added; after that the model reports changes through
+ * closeRequest and setAvailable.
+ *
+ * Each kind also has a dense array of its awake entities, the ones the
+ * model still needs to update. Entities are awake when added; the model
+ * puts them to sleep and wakes them through setAwake.
+ */
+class EntityStore {
+ public:
+  /**
+   * @brief Files an entity under its kind
+   * @param entity Entity to add, whose id must not already be stored
+   * @return Handle to the entity
+   */
+  EntityHandle add(IEntity* entity);
+
+  /**
+   * @brief Removes an entity
+   * @param id Id of the entity to remove
+   * @return The removed entity, or nullptr if no entity has that id
+   */
+  IEntity* remove(int id);
+
+  /**
+   * @brief Finds an entity by id
+   * @param id Id of the entity
+   * @return The entity, or nullptr if no entity has that id
+   */
+  IEntity* get(int id) const;
+
+  /**
+   * @brief Finds an entity by handle
+   * @param handle Handle returned by add
+   * @return The entity, or nullptr if it has since been removed
+   */
+  IEntity* get(EntityHandle handle) const;
+
+  /**
+   * @brief Gets the handle of an entity
+   * @param id Id of the entity
+   * @return The handle, or a stale handle if no entity has that id
+   */
+  EntityHandle handleOf(int id) const;
+
+  /**
+   * @return Number of stored entities
+   */
+  int size() const { return slots.size() - freeSlots.size(); }
+
+  const std::vector<Drone*>& drones() const { return droneArray.items; }
+  const std::vector<Package*>& packages() const { return packageArray.items; }
+  const std::vector<Robot*>& robots() const { return robotArray.items; }
+  const std::vector<ChargingStation*>& stations() const {
+    return stationArray.items;
+  }
+  /**
+   * @return Every entity without a dedicated array (humans, helicopters)
+   */
+  const std::vector<IEntity*>& others() const { return otherArray.items; }
+
+  const std::vector<Drone*>& awakeDrones() const {
+    return awakeDroneArray.items;
+  }
+  const std::vector<Package*>& awakePackages() const {
+    return awakePackageArray.items;
+  }
+  const std::vector<Robot*>& awakeRobots() const {
+    return awakeRobotArray.items;
+  }
+  const std::vector<ChargingStation*>& awakeStations() const {
+    return awakeStationArray.items;
+  }
+  const std::vector<IEntity*>& awakeOthers() const {
+    return awakeOtherArray.items;
+  }
+
+  /**
+   * @return Number of awake entities of every kind
+   */
+  int awakeCount() const {
+    return awakeDroneArray.items.size() + awakePackageArray.items.size() +
+           awakeRobotArray.items.size() + awakeStationArray.items.size() +
+           awakeOtherArray.items.size();
+  }
+
+  /**
+   * @brief Wakes an entity or puts it to sleep
+   * @param entity A stored entity
+   * @param awake Whether the model must update it
+   */
+  void setAwake(IEntity* entity, bool awake);
+
+  /**
+   * @brief Finds every entity with a name
+   * @param name Name to look up
+   * @return The entities, in the order they were added
+   */
+  const std::vector<IEntity*>& named(const std::string& name) const;
+
+  /**
+   * @brief Finds the oldest robot with a name that is still waiting for a
+   * delivery
+   * @param name Name of the robot
+   * @return The robot, or nullptr if there is none
+   */
+  Robot* openRequest(const std::string& name) const;
+
+  /**
+   * @brief Finds the oldest package with a name that has not been scheduled
+   * @param name Name of the package
+   * @return The package, or nullptr if there is none
+   */
+  Package* openPackage(const std::string& name) const;
+
+  /**
+   * @brief Drops a robot and its package from the open request indexes once
+   * their delivery is scheduled
+   * @param robot Robot whose request was met
+   * @param package Package that will be delivered to it
+   */
+  void closeRequest(Robot* robot, Package* package);
+
+  /**
+   * @brief Files a drone as available or busy
+   * @param drone Drone whose availability changed
+   * @param available Whether it can take a delivery
+   */
+  void setAvailable(Drone* drone, bool available);
+
+  /**
+   * @return Available drones keyed by weight capacity, lightest first
+   */
+  const std::map<int, std::vector<Drone*>>& availableDrones() const {
+    return availableByWeight;
+  }
+
+  /**
+   * @return Number of available drones across all weight classes
+   */
+  int availableCount() const { return availableSlot.size(); }
+
+  /**
+   * @brief Calls f on every entity, one kind at a time
+   * @param f Callable taking an IEntity*
+   */
+  template <class F>
+  void forEach(F f) const {
+    for (Drone* d : droneArray.items) f(d);
+    for (Package* p : packageArray.items) f(p);
+    for (Robot* r : robotArray.items) f(r);
+    for (ChargingStation* c : stationArray.items) f(c);
+    for (IEntity* e : otherArray.items) f(e);
+  }
+
+ private:
+  template <class T>
+  struct DenseArray {
+    std::vector<T*> items;
+    std::vector<int> slots;  // slot of each item, to fix up on swap
+  };
+
+  struct Slot {
+    IEntity* entity = nullptr;
+    EntityKind kind = EntityKind::Other;
+    int dense = -1;
+    int awake = -1;  // index in the kind's awake array, or -1 asleep
+    int generation = 0;
+  };
+
+  template <class T>
+  int insert(DenseArray<T>& array, T* item, int slot);
+  template <class T>
+  void erase(DenseArray<T>& array, int dense, int Slot::*index);
+
+  std::vector<Slot> slots;
+  std::vector<int> freeSlots;
+  void index(IEntity* entity);
+  void unindex(IEntity* entity);
+
+  std::unordered_map<int, int> slotById;
+  std::unordered_map<std::string, std::vector<IEntity*>> byName;
+  std::unordered_map<std::string, std::vector<Robot*>> openRobots;
+  std::unordered_map<std::string, std::vector<Package*>> openPackages;
+  std::map<int, std::vector<Drone*>> availableByWeight;
+  std::unordered_map<const Drone*, int> availableSlot;
+  DenseArray<Drone> droneArray;
+  DenseArray<Package> packageArray;
+  DenseArray<Robot> robotArray;
+  DenseArray<ChargingStation> stationArray;
+  DenseArray<IEntity> otherArray;
+  DenseArray<Drone> awakeDroneArray;
+  DenseArray<Package> awakePackageArray;
+  DenseArray<Robot> awakeRobotArray;
+  DenseArray<ChargingStation> awakeStationArray;
+  DenseArray<IEntity> awakeOtherArray;
+};
+
+#endif  // ENTITY_STORE_H_
@@ -0,0 +1,22 @@
+#ifndef GREEDY_DISPATCHER_H_
+#define GREEDY_DISPATCHER_H_
+
+#include "IDispatcher.h"
+
+/**
+ * @class GreedyDispatcher
+ * @brief Takes pending packages oldest first and gives each the fastest
+ * available drone, preferring drones that need no recharge. Each package
+ * scans every drone that can carry it.
+ */
+class GreedyDispatcher : public IDispatcher {
+ public:
+  /**
+   * @brief Assigns pending deliveries one package at a time
+   * @param model Model whose available drones and charging stations to use
+   * @param pending Packages waiting for a drone, oldest first
+   */
+  void dispatch(SimulationModel& model, std::deque<Package*>& pending);
+};
+
+#endif
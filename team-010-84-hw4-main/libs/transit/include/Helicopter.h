@@ -1,6 +1,8 @@
 #ifndef Helicopter_H_
 #define Helicopter_H_
 
+#include <memory>
+
 #include "IEntity.h"
 #include "IStrategy.h"
 
@@ -14,10 +16,12 @@ class Helicopter : public IEntity {
 
   ~Helicopter();
 
+  EntityKind getKind() const { return EntityKind::Helicopter; }
+
   void update(double dt);
 
  private:
-  IStrategy* movement = nullptr;
+  std::unique_ptr<IStrategy> movement;
 };
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef HUMAN_H_
 #define HUMAN_H_
 
+#include <memory>
+
 #include "IEntity.h"
 #include "IStrategy.h"
 
@@ -14,10 +16,13 @@ class Human : public IEntity {
 
   ~Human();
 
+  EntityKind getKind() const { return EntityKind::Human; }
+
   void update(double dt);
 
  private:
-  IStrategy* movement = nullptr;
+  std::unique_ptr<IStrategy> movement;
+  int hub = -1;  // the RoutePool hub the current walk ends at
 };
 
 #endif
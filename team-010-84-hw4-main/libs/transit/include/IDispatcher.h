@@ -0,0 +1,75 @@
+#ifndef I_DISPATCHER_H_
+#define I_DISPATCHER_H_
+
+#include <deque>
+
+#include "ChargingStation.h"
+#include "Drone.h"
+#include "Package.h"
+
+class SimulationModel;
+
+/**
+ * @brief What it would take for a drone to deliver a package and then
+ * reach a charging station
+ */
+struct DeliveryQuote {
+  /**
+   * @brief Whether the drone can carry the package and its battery could
+   * ever hold the charge for the trip
+   */
+  bool feasible = false;
+  /**
+   * @brief Whether the drone has the charge for the trip right now, rather
+   * than after recharging
+   */
+  bool ready = false;
+  /**
+   * @brief Distance from the drone to the package, on to its destination
+   * and then to the charging station
+   */
+  double distance = 0;
+  /**
+   * @brief Time the drone needs to fly that distance
+   */
+  double time = 0;
+};
+
+/**
+ * @brief Dispatcher interface. A dispatcher hands scheduled deliveries to
+ * available drones; the model calls it once per dispatch interval.
+ */
+class IDispatcher {
+ public:
+  /**
+   * @brief Destructor
+   */
+  virtual ~IDispatcher() {}
+
+  /**
+   * @brief Speed used to weigh a charging station's wait against its
+   * distance while the drone is still to be chosen; that of a medium drone
+   */
+  static constexpr double kStationSpeed = 30;
+
+  /**
+   * @brief Assigns as many pending deliveries as it can. Assigned packages
+   * are taken out of pending; the rest stay, in order, for the next call.
+   * @param model Model whose available drones and charging stations to use
+   * @param pending Packages waiting for a drone, oldest first
+   */
+  virtual void dispatch(SimulationModel& model,
+                        std::deque<Package*>& pending) = 0;
+
+  /**
+   * @brief Prices a delivery
+   * @param drone Drone that would fly it
+   * @param package Package to deliver
+   * @param endStation Charging station the drone ends up at
+   * @return The quote
+   */
+  static DeliveryQuote quote(Drone* drone, Package* package,
+                             ChargingStation* endStation);
+};
+
+#endif
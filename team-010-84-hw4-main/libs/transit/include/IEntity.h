@@ -5,23 +5,39 @@
 
 #include "graph.h"
 #include "math/vector3.h"
+#include "util/Random.h"
 #include "util/json.h"
 
 class SimulationModel;
 
+/**
+ * @brief The concrete kinds of entity, so the model can keep each kind in
+ * its own storage without RTTI.
+ */
+enum class EntityKind {
+  Drone,
+  Package,
+  Robot,
+  ChargingStation,
+  Human,
+  Helicopter,
+  Other
+};
+
 /**
  * @class IEntity
  * @brief Represents an entity in a physical system.
  *
- * An IEntity object has a unique ID, a position, a direction, a destination,
- * and details. It also has a speed, which determines how fast the entity moves
- * in the physical system. Subclasses of IEntity can override the `Update`
- * function to implement their own movement behavior.
+ * An IEntity object has an ID unique within its model, a position, a
+ * direction, a destination, and details. It also has a speed, which
+ * determines how fast the entity moves in the physical system. Subclasses of
+ * IEntity can override the `Update` function to implement their own movement
+ * behavior.
  */
 class IEntity {
  public:
   /**
-   * @brief Constructor that assigns a unique ID to the entity.
+   * @brief Constructor. The entity has no ID until it is linked to a model.
    */
   IEntity();
 
@@ -40,8 +56,10 @@ class IEntity {
    *  giving it access to the model's public variables
    *  and functions.
    * @param[in] model The simulation model to link.
+   * @param[in] id The ID the model gives the entity, unique within it. It
+   * also picks the entity's stream of the model's random numbers.
    */
-  virtual void linkModel(SimulationModel* model);
+  virtual void linkModel(SimulationModel* model, int id);
 
   /**
    * @brief Gets the ID of the entity.
@@ -49,6 +67,19 @@ class IEntity {
    */
   virtual int getId() const;
 
+  /**
+   * @brief Gets the kind of the entity.
+   * @return The kind of the entity.
+   */
+  virtual EntityKind getKind() const;
+
+  /**
+   * @brief Whether update would do nothing until another entity or the
+   * model acts on this one, so the model may stop updating it until then.
+   * @return True if the entity is idle.
+   */
+  virtual bool isIdle() const;
+
   /**
    * @brief Gets the position of the entity.
    * @return The position of the entity.
@@ -77,7 +108,7 @@ class IEntity {
    * @brief Gets the name of the entity
    * @return The name of the entity
    */
-  virtual std::string getName() const;
+  virtual const std::string& getName() const;
 
   /**
    * @brief Gets the speed of the entity.
@@ -124,6 +155,7 @@ class IEntity {
   std::string color;
   std::string name;
   double speed = 0;
+  RandomStream random;
 };
 
 #endif
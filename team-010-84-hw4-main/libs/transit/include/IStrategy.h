@@ -1,21 +1,40 @@
 #ifndef I_STRATEGY_H_
 #define I_STRATEGY_H_
 
+#include <cstddef>
+
 #include "IEntity.h"
+#include "util/BlockPool.h"
 
 /**
  * @brief Strategy interface
  *
+ * Entities replace their strategy on every leg of every trip, so strategies
+ * and decorators are allocated from the shared BlockPool rather than the
+ * heap. Whoever holds a strategy owns it, through a std::unique_ptr.
  */
 class IStrategy {
  public:
+  virtual ~IStrategy() {}
+
+  static void* operator new(std::size_t size) {
+    return BlockPool::shared().allocate(size);
+  }
+
+  // the virtual destructor makes size that of the most derived class
+  static void operator delete(void* block, std::size_t size) {
+    BlockPool::shared().deallocate(block, size);
+  }
+
  /**
   * @brief Move toward next position
   * 
   * @param entity Entity to move
   * @param dt Delta Time
+  * @return The part of dt left over once the strategy completed, for
+  * whatever the entity does next; 0 if it used all of dt
   */
-  virtual void move(IEntity* entity, double dt) = 0;
+  virtual double move(IEntity* entity, double dt) = 0;
 
   /**
    * @brief Check if the trip is completed
@@ -0,0 +1,34 @@
+#ifndef JUMP_CELEBRATION_H_
+#define JUMP_CELEBRATION_H_
+
+#include "CelebrationStrategy.h"
+
+/**
+ * @brief this class represents a celebration where the entity jumps up and
+ * down.
+ */
+class JumpCelebration : public Celebration<JumpCelebration> {
+ public:
+  /**
+   * @brief Construct a new Jump Celebration object
+   *
+   * @param[in] time how long to celebrate
+   * @param[in] jumpHeight how far up to jump
+   */
+  explicit JumpCelebration(double time = 4, double jumpHeight = 10);
+
+  /**
+   * @brief Make the entity jump for dt.
+   *
+   * @param entity Entity to celebrate
+   * @param dt Delta Time
+   */
+  void act(IEntity* entity, double dt);
+
+ private:
+  double jumpHeight = 10;
+  bool up = true;
+  double h = 0;
+};
+
+#endif  // JUMP_CELEBRATION_H_
@@ -0,0 +1,25 @@
+#ifndef NULL_CONTROLLER_H_
+#define NULL_CONTROLLER_H_
+
+#include "IController.h"
+
+/**
+ * @class NullController
+ * @brief Controller without a view, for running the simulation headless.
+ * It drops everything the model sends and only remembers whether the
+ * model asked to stop.
+ */
+class NullController : public IController {
+ public:
+  void addEntity(const IEntity& entity) {}
+  void updateEntity(const IEntity& entity) {}
+  void removeEntity(const IEntity& entity) {}
+  void sendEventToView(const std::string& event, const JsonObject& details) {}
+  void stop() { alive = false; }
+  bool isAlive() { return alive; }
+
+ private:
+  bool alive = true;
+};
+
+#endif
@@ -59,6 +59,25 @@ class Package : public IEntity {
   */
   void update(double dt);
 
+  /**
+   * @brief Gets the kind of the entity
+   * @return EntityKind::Package
+   */
+  EntityKind getKind() const { return EntityKind::Package; }
+
+  /**
+   * @brief Packages never move themselves, but one that a drone carries
+   * moves with it and so stays awake to be reported
+   * @return Whether it is not being carried
+   */
+  bool isIdle() const { return !carried; }
+
+  /**
+   * @brief Marks the package as picked up by a drone. Call from a serial
+   * phase, such as a deferred effect.
+   */
+  void pickUp();
+
   /**
    * @brief Sets the attributes for delivery
    * 
@@ -83,6 +102,7 @@ class Package : public IEntity {
   Vector3 destination;
   std::string strategyName;
   Robot* owner = nullptr;
+  bool carried = false;
   int weight = 5;
 };
 
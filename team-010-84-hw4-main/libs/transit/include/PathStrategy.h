@@ -1,32 +1,50 @@
 #ifndef PATH_STRATEGY_H_
 #define PATH_STRATEGY_H_
 
+#include <memory>
+#include <vector>
+
 #include "IStrategy.h"
+#include "waypoint_buffer.h"
 
 /**
  * @brief this class inhertis from the IStrategy class and is represents
- * a movement strategy where the entity simply moves along the given path
+ * a movement strategy where the entity simply moves along the given path.
+ * The entity first heads straight for the start of the path, then slides
+ * along it by distance, using the lengths the path already holds.
  */
 class PathStrategy : public IStrategy {
  protected:
-  std::vector<std::vector<float>> path;
-  int index;
+  std::shared_ptr<const routing::WaypointBuffer> path;
+  int index;          // next waypoint to reach
+  double along = 0;   // distance along the path, once on it
 
  public:
   /**
    * @brief Construct a new PathStrategy Strategy object
    *
+   * @param path the path to follow, as {x, y, z} waypoints
+   */
+  PathStrategy(const std::vector<std::vector<float>>& path = {});
+
+  /**
+   * @brief Construct a PathStrategy that follows a path it shares with
+   * other strategies, without copying it
+   *
    * @param path the path to follow
    */
-  PathStrategy(std::vector<std::vector<float>> path = {});
+  explicit PathStrategy(std::shared_ptr<const routing::WaypointBuffer> path);
 
   /**
-   * @brief Move toward next position in the path
+   * @brief Move along the path by the distance the entity covers in dt,
+   * passing as many waypoints as that takes, so any dt lands the entity
+   * exactly where it would be after many small steps
    *
    * @param entity Entity to move
    * @param dt Delta Time
+   * @return The time left over after reaching the end of the path
    */
-  virtual void move(IEntity* entity, double dt);
+  virtual double move(IEntity* entity, double dt);
 
   /**
    * @brief Check if the trip is completed by seeing if index 
@@ -31,6 +31,18 @@ class Robot : public IEntity {
   */
   void update(double dt);
 
+  /**
+   * @brief Gets the kind of the entity
+   * @return EntityKind::Robot
+   */
+  EntityKind getKind() const { return EntityKind::Robot; }
+
+  /**
+   * @brief Robots only wait for their package
+   * @return true
+   */
+  bool isIdle() const { return true; }
+
   /**
    * @brief Receives the passed in package
    *
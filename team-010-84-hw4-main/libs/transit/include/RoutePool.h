@@ -0,0 +1,88 @@
+#ifndef ROUTE_POOL_H_
+#define ROUTE_POOL_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PathStrategy.h"
+#include "graph.h"
+#include "math/vector3.h"
+#include "util/Random.h"
+
+/**
+ * @class RoutePool
+ * @brief Walking routes between a fixed set of hub nodes, shared by every
+ * human. Humans wander from hub to hub, so once each route has been found
+ * a crowd of any size walks without routing at all. A background thread
+ * finds the routes ahead of time. A route asked for before the thread
+ * reaches it is found on the spot, and it is the same route either way,
+ * so runs do not depend on how far the thread has got.
+ */
+class RoutePool {
+ public:
+  /**
+   * @brief Picks the hubs and starts finding routes between them
+   * @param graph Map to route on, which must outlive the pool
+   * @param hubs Number of hubs to pick; points that snap to the same node
+   * share a hub, so the pool may end up with fewer
+   * @param random Stream to pick hubs with
+   * @param low Corner of the area to pick hubs in, with the least x and z
+   * @param high Opposite corner, with the greatest x and z
+   */
+  RoutePool(const routing::IGraph* graph, int hubs, RandomStream random,
+            Vector3 low, Vector3 high);
+
+  /**
+   * @brief Stops the background thread
+   */
+  ~RoutePool();
+
+  RoutePool(const RoutePool&) = delete;
+  RoutePool& operator=(const RoutePool&) = delete;
+
+  /**
+   * @return Number of hubs
+   */
+  int size() const { return hubs.size(); }
+
+  /**
+   * @brief Finds the hub closest to a position
+   * @param position The position
+   * @return Index of the hub
+   */
+  int nearestHub(const Vector3& position) const;
+
+  /**
+   * @brief Returns the walking route between two hubs. Safe to call from
+   * any thread.
+   * @param from Index of the hub to start at
+   * @param to Index of the hub to end at
+   * @return The route's waypoints
+   */
+  std::shared_ptr<const routing::WaypointBuffer> route(int from, int to);
+
+  /**
+   * @return Number of routes found so far
+   */
+  int found() const { return routesFound; }
+
+ private:
+  struct Route {
+    std::once_flag computed;
+    std::shared_ptr<const routing::WaypointBuffer> path;
+  };
+
+  void warm();
+
+  const routing::IGraph* graph;
+  std::vector<std::vector<float>> hubs;
+  std::unique_ptr<Route[]> routes;
+  std::atomic<int> routesFound{0};
+  std::atomic<bool> stopping{false};
+  std::thread warmer;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef SCENARIO_H_
+#define SCENARIO_H_
+
+#include <string>
+#include <vector>
+
+#include "SimulationModel.h"
+#include "util/json.h"
+
+/**
+ * @brief A command the view would send the model, due at a simulated time
+ */
+struct ScenarioCommand {
+  double time = 0;
+  std::string command;
+  JsonObject params;
+};
+
+/**
+ * @class Scenario
+ * @brief A timed script of CreateEntity and ScheduleTrip commands, in the
+ * format of the scene files the view loads: a JSON array of
+ * {"command": ..., "params": {...}} objects. Each entry may also carry a
+ * "time" in simulated seconds; entries without one run at the start.
+ * Commands the model does not handle, such as AddMesh, are skipped.
+ */
+class Scenario {
+ public:
+  /**
+   * @brief Adds the commands in a file
+   * @param file Path of the JSON script
+   * @throws std::runtime_error if the file cannot be read or parsed
+   */
+  void load(const std::string& file);
+
+  /**
+   * @brief Adds a command after any others due at the same time
+   * @param command The command
+   */
+  void add(const ScenarioCommand& command);
+
+  /**
+   * @brief Gives access to the commands, in the order they run, to adjust
+   * them before the scenario starts
+   * @return The commands
+   */
+  std::vector<ScenarioCommand>& getCommands() { return commands; }
+
+  /**
+   * @brief Runs every command due by a time, in time order, then file
+   * order
+   * @param model Model to run them on
+   * @param time Simulated time
+   * @return Number of commands run
+   */
+  int apply(SimulationModel& model, double time);
+
+  /**
+   * @return Whether every command has run
+   */
+  bool done() const { return next >= commands.size(); }
+
+  /**
+   * @return Time of the next command to run, infinity once all have run
+   */
+  double nextTime() const;
+
+  /**
+   * @return Time of the last command
+   */
+  double endTime() const;
+
+  /**
+   * @return Number of commands
+   */
+  int size() const { return commands.size(); }
+
+ private:
+  std::vector<ScenarioCommand> commands;
+  int next = 0;
+};
+
+#endif
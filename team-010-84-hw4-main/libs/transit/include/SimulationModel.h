@@ -4,13 +4,25 @@
 #include "CompositeFactory.h"
 #include "Drone.h"
 #include "ChargingStation.h"
+#include "DeliveryLog.h"
+#include "EntityStore.h"
 #include "IController.h"
+#include "IDispatcher.h"
 #include "IEntity.h"
+#include "Package.h"
 #include "Robot.h"
+#include "RoutePool.h"
+#include "ThreadPool.h"
 #include "graph.h"
+#include "util/SpatialGrid.h"
 #include <deque>
-#include <map>
+#include <functional>
+#include <memory>
+#include <queue>
 #include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 //--------------------  Model ----------------------------
 
@@ -35,11 +47,103 @@ class SimulationModel {
   ~SimulationModel();
 
   /**
-   * @brief Set the Graph for the SimulationModel
+   * @brief Set the Graph for the SimulationModel. The model does not own
+   * the graph, which may be shared read-only between models.
    * @param graph Type IGraph* contains the new graph for SimulationModel
    **/
   void setGraph(const routing::IGraph* graph) { this->graph = graph; }
 
+  /**
+   * @brief Replaces the policy that hands scheduled deliveries to drones
+   * @param dispatcher New dispatcher, owned by the model from now on
+   * @param interval Simulated seconds between dispatches; 0 dispatches
+   * every update
+   **/
+  void setDispatcher(IDispatcher* dispatcher, double interval);
+
+  /**
+   * @brief Sets how many threads update drones, humans and helicopters.
+   * With more than one, those entities update in parallel and anything
+   * they do to other entities is deferred to a serial commit phase.
+   * @param threads Threads to use, counting the caller; 1 updates serially
+   **/
+  void setWorkerThreads(int threads);
+
+  /**
+   * @brief Runs an effect on other entities. During a parallel update the
+   * effect is queued and run after every entity has updated, in entity
+   * order; otherwise it runs at once.
+   * @param effect The effect
+   **/
+  void defer(std::function<void()> effect);
+
+  /**
+   * @brief Seeds the random numbers that decide where humans and
+   * helicopters wander. Each entity draws from its own stream of them, so a
+   * seed gives the same run whatever the number of threads. Applies to
+   * entities created after the call.
+   * @param seed The seed
+   **/
+  void setSeed(uint64_t seed) { this->seed = seed; }
+
+  /**
+   * @brief Sets how many hubs humans wander between. Routes between every
+   * pair of hubs are found once, in the background, when the first human
+   * is created, and shared by all of them; more hubs give more varied
+   * walks for more routing up front.
+   * @param hubs Number of hubs, at least 2
+   **/
+  void setWalkingHubs(int hubs) { walkingHubs = hubs; }
+
+  /**
+   * @brief Returns the walking routes humans share
+   * @return The pool, or nullptr before a human is created on a map
+   **/
+  RoutePool* getRoutePool() { return routePool.get(); }
+
+  /**
+   * @brief Returns the seed of the model's random numbers
+   * @return The seed
+   **/
+  uint64_t getSeed() const { return seed; }
+
+  /**
+   * @brief Resumes updating an entity the model stopped updating because it
+   * was idle. Call from a serial phase, such as a deferred effect.
+   * @param entity Entity to wake
+   **/
+  void wake(IEntity* entity);
+
+  /**
+   * @brief Wakes an entity once the clock reaches a time, for entities
+   * that know when their next event is due
+   * @param entity Entity to wake
+   * @param at Simulated time to wake it at
+   **/
+  void wakeAt(IEntity* entity, double at);
+
+  /**
+   * @brief Counts drones plugged in, whose batteries change without them
+   * being updated
+   * @param change 1 as a drone plugs in, -1 as one unplugs
+   **/
+  void chargingChanged(int change) { charging += change; }
+
+  /**
+   * @brief Returns when the next update can change anything: now if any
+   * entity is awake, otherwise the earliest timed wake-up or dispatch
+   * @return Simulated time of the next event, infinity if there is none
+   **/
+  double nextEventTime() const;
+
+  /**
+   * @brief Jumps the clock over idle time, toward a time but never past
+   * the next event. Nothing is updated in between.
+   * @param until Time to advance to, such as the next external command
+   * @return The time reached
+   **/
+  double skipTo(double until);
+
   /**
    * @brief Creates a new simulation entity
    * @param entity Type JsonObject contain the entity's reference to decide
@@ -63,7 +167,8 @@ class SimulationModel {
   void scheduleTrip(JsonObject& details);
 
   /**
-   * @brief Update the simulation
+   * @brief Update the simulation. Only awake entities are updated; each
+   * falls asleep once idle until something wakes it.
    * @param dt Type double contain the time since update was last called.
    **/
   void update(double dt);
@@ -74,13 +179,70 @@ class SimulationModel {
    **/
   void stop();
 
-    /**
-   * @brief Returns the closest charging station to the target entity
-   * @param target target entity
+  /**
+   * @brief Returns the closest charging station to a position
+   * @param position Where to search from
    * @return ChargingStation* which is the nearest charging station
    **/
   ChargingStation* getClosestRechargeStation(Vector3 position);
 
+  /**
+   * @brief Returns the charging station a drone would be charging at
+   * soonest: the one with the least flight time plus estimated wait for a
+   * slot. Call from a serial phase, as it reads the stations' queues.
+   * @param position Where the drone would fly from
+   * @param speed Speed of the drone, to weigh waiting against flying
+   * @param tentative Load already promised to stations that they have not
+   * been told of, if any
+   * @return The station, nullptr if there are none
+   **/
+  ChargingStation* getBestRechargeStation(
+      Vector3 position, double speed,
+      const std::unordered_map<ChargingStation*, StationLoad>* tentative =
+          nullptr);
+
+  /**
+   * @brief Keeps the available drone index in step with a drone
+   * @param drone Drone whose availability changed
+   * @param available Whether it can take a delivery
+   **/
+  void setDroneAvailable(Drone* drone, bool available) {
+    entities.setAvailable(drone, available);
+  }
+
+  /**
+   * @brief Records that a drone took a scheduled delivery
+   * @param package The package it will carry
+   **/
+  void packageAssigned(Package* package);
+
+  /**
+   * @brief Records that a package reached its robot
+   * @param package The package
+   **/
+  void packageDelivered(Package* package);
+
+  /**
+   * @brief Returns the simulated time, the sum of every update's dt
+   *
+   * @returns double seconds since the simulation started
+  */
+  double getTime() const { return time; }
+
+  /**
+   * @brief Returns the log of every scheduled delivery
+   *
+   * @returns const DeliveryLog& the log
+  */
+  const DeliveryLog& getDeliveryLog() const { return deliveries; }
+
+  /**
+   * @brief Returns the entities of the simulation, indexed by kind
+   *
+   * @returns const EntityStore& the entities
+  */
+  const EntityStore& getEntities() const { return entities; }
+
   /**
    * @brief Returns the graph of the map
    *
@@ -92,11 +254,36 @@ class SimulationModel {
 
  protected:
   IController& controller;
-  std::map<int, IEntity*> entities;
+  EntityStore entities;
   std::set<int> removed;
   void removeFromSim(int id);
-  const routing::IGraph* graph;
+  void indexStations();
+  void updateDrones(double dt);
+  void updateStations(double dt);
+  void updateOthers(double dt);
+  template <class T>
+  void updateAll(const std::vector<T*>& items, double dt);
+  template <class T>
+  void sleepIdle(const std::vector<T*>& items);
+  void dispatchDeliveries(double dt);
+  const routing::IGraph* graph = nullptr;
   CompositeFactory entityFactory;
+  IDispatcher* dispatcher = nullptr;
+  double dispatchInterval = 0;
+  double sinceDispatch = 0;
+  ThreadPool* workers = nullptr;
+  double time = 0;
+  DeliveryLog deliveries;
+  int nextId = 0;
+  uint64_t seed = 0;
+  int walkingHubs = 32;
+  int charging = 0;
+  std::unique_ptr<RoutePool> routePool;
+  static constexpr double kStationCell = 250;
+  SpatialGrid stationGrid{kStationCell};
+  typedef std::pair<double, int> Wakeup;
+  std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup>>
+      wakeups;
 };
 
 #endif
@@ -0,0 +1,163 @@
+#ifndef SIMULATION_THREAD_H_
+#define SIMULATION_THREAD_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "IController.h"
+#include "SimulationModel.h"
+#include "util/TripleBuffer.h"
+
+/**
+ * @brief Where an entity is and how it looks at the end of a tick
+ */
+struct EntityState {
+  int id = -1;
+  Vector3 position;
+  Vector3 direction;
+  std::string color;
+  long changed = 0;  // tick it last changed on
+
+  /**
+   * @brief Copies the state of an entity
+   * @param entity Entity to copy
+   * @return Its state
+   */
+  static EntityState of(const IEntity& entity);
+
+  /**
+   * @brief Formats the state as the view expects it
+   * @return {id, pos, dir} plus color if the entity has one
+   */
+  JsonObject toJson() const;
+};
+
+/**
+ * @brief Every entity's state at the end of one tick
+ */
+struct WorldSnapshot {
+  long tick = 0;
+  double time = 0;
+  std::vector<EntityState> entities;
+  std::unordered_map<int, int> slots;  // index in entities, by id
+};
+
+/**
+ * @brief A message from the simulation to the view
+ */
+struct SimulationEvent {
+  std::string event;
+  JsonObject details;
+};
+
+/**
+ * @class SimulationThread
+ * @brief Runs a SimulationModel on its own thread at a fixed tick rate,
+ * however many viewers are connected and however often they ask for
+ * updates. Other threads never touch the model: they post commands that run
+ * between ticks, read the latest WorldSnapshot, and drain the events the
+ * model sent to the view. The snapshot and events are each meant for a
+ * single reader thread.
+ *
+ * Only entities the model reports as updated, added or removed are copied
+ * into a snapshot; the rest keep the state they had, so idle entities cost
+ * nothing per tick. Each state records the tick it last changed on, so
+ * viewers can send just what changed since they last looked.
+ */
+class SimulationThread : public IController {
+ public:
+  /**
+   * @brief Creates the model; the thread starts with start()
+   * @param tickRate Ticks per second of wall-clock time
+   */
+  explicit SimulationThread(double tickRate = 60);
+
+  /**
+   * @brief Stops and joins the thread
+   */
+  ~SimulationThread();
+
+  /**
+   * @brief Gives access to the model to set it up. Once the thread is
+   * running, use post instead.
+   * @return The model
+   */
+  SimulationModel& getModel() { return model; }
+
+  /**
+   * @brief Starts ticking
+   */
+  void start();
+
+  /**
+   * @brief Runs a command on the simulation thread before the next tick
+   * @param command Callable taking the model
+   */
+  void post(std::function<void(SimulationModel&)> command);
+
+  /**
+   * @brief Sets how many simulated seconds pass per second of wall-clock
+   * time
+   * @param speed The speed, 1 for real time
+   */
+  void setSpeed(double speed) { this->speed = speed; }
+
+  /**
+   * @brief Picks up the newest snapshot
+   * @return The snapshot, valid until the next call
+   */
+  const WorldSnapshot& latest();
+
+  /**
+   * @brief Takes the events sent to the view since the last call
+   * @return The events, oldest first
+   */
+  std::vector<SimulationEvent> drainEvents();
+
+  // IController, called by the model on the simulation thread
+  void addEntity(const IEntity& entity);
+  void updateEntity(const IEntity& entity);
+  void removeEntity(const IEntity& entity);
+  void sendEventToView(const std::string& event, const JsonObject& details);
+  void stop() { alive = false; }
+  bool isAlive() { return alive; }
+
+ private:
+  void run();
+  void runCommands();
+  void publish();
+  void queueEvent(const std::string& event, const JsonObject& details);
+  void changed(int id);
+  void catchUp(WorldSnapshot& snapshot);
+  void rebuild(WorldSnapshot& snapshot);
+
+  SimulationModel model;
+  double tickRate;
+  std::atomic<double> speed{1.0};
+  std::atomic<bool> alive{true};
+  std::thread thread;
+  long tick = 0;
+  double time = 0;
+
+  std::mutex commandMutex;
+  std::deque<std::function<void(SimulationModel&)>> commands;
+
+  std::mutex eventMutex;
+  std::vector<SimulationEvent> events;
+
+  TripleBuffer<WorldSnapshot> snapshots;
+  // ids changed on recent ticks, oldest first, and the tick each entity
+  // last changed on. Snapshots older than forgotten are rebuilt in full.
+  std::deque<std::pair<long, int>> changes;
+  std::unordered_map<int, long> changedAt;
+  long forgotten = 0;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SPIN_CELEBRATION_H_
+#define SPIN_CELEBRATION_H_
+
+#include "CelebrationStrategy.h"
+
+/**
+ * @brief this class represents a celebration where the entity spins in
+ * place.
+ */
+class SpinCelebration : public Celebration<SpinCelebration> {
+ public:
+  /**
+   * @brief Construct a new Spin Celebration object
+   *
+   * @param[in] time how long to celebrate
+   * @param[in] spinSpeed multiplier for how fast to spin
+   */
+  explicit SpinCelebration(double time = 4, double spinSpeed = 1);
+
+  /**
+   * @brief Spin the entity for dt.
+   *
+   * @param entity Entity to spin
+   * @param dt Delta Time
+   */
+  void act(IEntity* entity, double dt);
+
+ private:
+  double spinSpeed = 1;
+};
+
+#endif  // SPIN_CELEBRATION_H_
@@ -0,0 +1,63 @@
+#ifndef STATE_FRAME_H_
+#define STATE_FRAME_H_
+
+#include <cstdint>
+#include <string>
+
+#include "SimulationThread.h"
+
+/**
+ * @class StateFrame
+ * @brief Packs entity states into one compact message for the view, in
+ * place of an UpdateEntity JSON message per entity.
+ *
+ * The payload is little-endian: a header of the tick (uint32) and the
+ * number of records (uint32), then one 18-byte record per entity:
+ * id (uint32), flags (uint16), position (3 x int16, in eighths of a unit)
+ * and direction (3 x int16, scaled so 32767 is 1). Positions beyond
+ * +/-4096 are clamped. The web server only sends text frames, so the
+ * payload goes out base64 encoded behind a one-character marker, which
+ * JSON messages never start with.
+ */
+class StateFrame {
+ public:
+  static const char kMarker = 'B';
+  static const int kHeaderBytes = 8;
+  static const int kRecordBytes = 18;
+  static constexpr double kPositionScale = 8;
+  static constexpr double kDirectionScale = 32767;
+
+  /// Set when the entity is tinted with the color it was created with.
+  static const uint16_t kHasColor = 1;
+
+  /**
+   * @brief Starts an empty frame
+   * @param tick Tick the states are from
+   */
+  explicit StateFrame(long tick);
+
+  /**
+   * @brief Appends an entity's state
+   * @param state The state
+   */
+  void add(const EntityState& state);
+
+  /**
+   * @return Number of states added
+   */
+  int size() const { return count; }
+
+  /**
+   * @return The frame as the text message to send
+   */
+  std::string toText() const;
+
+ private:
+  void put16(uint16_t value);
+  void put32(uint32_t value);
+
+  std::string bytes;
+  int count = 0;
+};
+
+#endif  // STATE_FRAME_H_
@@ -0,0 +1,64 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that split loops between them. The
+ * calling thread works too, so a pool of n threads runs n + 1 chunks at
+ * once.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief Starts the workers
+   * @param threads Number of worker threads besides the caller
+   */
+  explicit ThreadPool(int threads);
+
+  /**
+   * @brief Stops and joins the workers
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @return Number of threads that share a loop, including the caller
+   */
+  int size() const { return workers.size() + 1; }
+
+  /**
+   * @brief Runs work over [0, count) in chunks and returns once every chunk
+   * is done. Chunks may run in any order and on any thread.
+   * @param count Number of items
+   * @param work Callable taking the [begin, end) range of a chunk
+   */
+  void parallelFor(int count, const std::function<void(int, int)>& work);
+
+ private:
+  void workerLoop();
+  void runChunks();
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const std::function<void(int, int)>* job = nullptr;
+  int jobCount = 0;
+  int chunkSize = 1;
+  int chunks = 0;
+  std::atomic<int> nextChunk{0};
+  int active = 0;
+  long generation = 0;
+  bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef VIEW_STATE_H_
+#define VIEW_STATE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "SimulationThread.h"
+
+/**
+ * @class ViewState
+ * @brief Remembers what one view was last sent of each entity, so it is
+ * sent only the entities that visibly moved or turned since.
+ *
+ * Moves shorter than kPositionThreshold and turns smaller than about one
+ * degree are held back. They add up, so every kKeyframeTicks a keyframe
+ * resends every entity whose state differs at all from what the view was
+ * last sent. Entities that have not moved are never resent, keyframes
+ * included, so a state counts as acknowledged once it is sent: the view
+ * must apply every state it receives, keeping those for entities it is
+ * still loading until they are ready (see moveEntity in main.js).
+ */
+class ViewState {
+ public:
+  static constexpr double kPositionThreshold = 0.25;
+  static constexpr double kDirectionCosine = 0.99985;
+  static const long kKeyframeTicks = 300;
+
+  /**
+   * @brief Picks the states of a snapshot the view needs and records them
+   * as sent
+   * @param snapshot The newest snapshot
+   * @return The states to send, pointing into the snapshot
+   */
+  std::vector<const EntityState*> update(const WorldSnapshot& snapshot);
+
+  /**
+   * @return Tick of the last snapshot the view was updated from, or -1
+   */
+  long getTick() const { return lastTick; }
+
+ private:
+  struct Sent {
+    Vector3 position;
+    Vector3 direction;
+  };
+
+  bool needs(const EntityState& state, bool keyframe);
+
+  std::unordered_map<int, Sent> sent;
+  long lastTick = -1;
+  long lastKeyframe = -1;
+};
+
+#endif  // VIEW_STATE_H_
@@ -0,0 +1,61 @@
+#ifndef FLOAT4_H_
+#define FLOAT4_H_
+
+#include <cmath>
+
+#include "math/vector3.h"
+
+/**
+ * @brief Four floats aligned to 16 bytes, so arrays of them fill SIMD
+ * registers and cache lines evenly. For batch code that stores many points:
+ * x, y and z hold the point and w is free for something that goes with it.
+ */
+struct alignas(16) Float4 {
+  float x = 0;
+  float y = 0;
+  float z = 0;
+  float w = 0;
+
+  constexpr Float4() {}
+  constexpr Float4(float x, float y, float z, float w = 0)
+      : x(x), y(y), z(z), w(w) {}
+  /**
+   * @brief Narrows a Vector3 to floats
+   * @param v The vector
+   * @param w The fourth component
+   */
+  constexpr explicit Float4(const Vector3& v, float w = 0)
+      : x(v.x), y(v.y), z(v.z), w(w) {}
+
+  constexpr Float4 operator+(const Float4& v) const {
+    return Float4(x + v.x, y + v.y, z + v.z, w + v.w);
+  }
+  constexpr Float4 operator-(const Float4& v) const {
+    return Float4(x - v.x, y - v.y, z - v.z, w - v.w);
+  }
+  constexpr Float4 operator*(float s) const {
+    return Float4(x * s, y * s, z * s, w * s);
+  }
+
+  /**
+   * @return The dot product of the x, y and z parts
+   */
+  constexpr float dot3(const Float4& v) const {
+    return x * v.x + y * v.y + z * v.z;
+  }
+  /**
+   * @return The distance between the x, y and z parts
+   */
+  float dist3(const Float4& v) const {
+    Float4 d = *this - v;
+    return std::sqrt(d.dot3(d));
+  }
+  /**
+   * @return The x, y and z parts, widened
+   */
+  constexpr Vector3 xyz() const { return Vector3(x, y, z); }
+};
+
+static_assert(sizeof(Float4) == 16, "Float4 must pack into 16 bytes");
+
+#endif
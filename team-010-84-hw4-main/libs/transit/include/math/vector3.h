@@ -3,8 +3,10 @@
 
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
 
-// a simple class used for vector math, most function are self explanatory
+// a simple class used for vector math, most function are self explanatory.
+// Everything is defined here so calls inline wherever they are made.
 class Vector3 {
   public:
     double x = 0;
@@ -13,8 +15,8 @@ class Vector3 {
     /**
      * @brief Default constructor.
      */
-    Vector3();
-    Vector3(double a);
+    constexpr Vector3() {}
+    constexpr Vector3(double a) : x(a), y(a), z(a) {}
     /**
      * @brief Parameter constructor.
      *
@@ -22,24 +24,34 @@ class Vector3 {
      * @param[in] b y-coordinate
      * @param[in] c z-coordinate
      */
-    Vector3(double a, double b, double c);
-    bool operator==(const Vector3& v) const;
-    double& operator[](int i);
-    double operator[](int i) const;
+    constexpr Vector3(double a, double b, double c) : x(a), y(b), z(c) {}
+    constexpr bool operator==(const Vector3& v) const {
+      return distSquared(v) < kEpsilon * kEpsilon;
+    }
+    constexpr double& operator[](int i) {
+      return i == 0 ? x : i == 1 ? y : i == 2 ? z : (outOfRange(), x);
+    }
+    constexpr double operator[](int i) const {
+      return i == 0 ? x : i == 1 ? y : i == 2 ? z : (outOfRange(), x);
+    }
     /**
      * @brief Overrides + operator.
      * @param[in] v The Vector3 object you would like to add to this Vector3
      * object
      * @return The Vector3 Object comprised of the sum of the two objects
      */
-    Vector3 operator+(const Vector3& v) const;
+    constexpr Vector3 operator+(const Vector3& v) const {
+      return Vector3(x + v.x, y + v.y, z + v.z);
+    }
     /**
      * @brief Overrides - operator.
      * @param[in] v The Vector3 object you would like to subtract to this Vector3
      * object
      * @return The Vector3 Object comprised of the subtraction of the two objects
      */
-    Vector3 operator-(const Vector3& v) const;
+    constexpr Vector3 operator-(const Vector3& v) const {
+      return Vector3(x - v.x, y - v.y, z - v.z);
+    }
     /**
      * @brief Overrides * operator.
      * @param[in] v The Vector3 object you would like to multiply to this Vector3
@@ -47,21 +59,70 @@ class Vector3 {
      * @return The Vector3 Object comprised of the multiplication of the two
      * objects
      */
-    Vector3 operator*(double s) const;
+    constexpr Vector3 operator*(double s) const {
+      return Vector3(x * s, y * s, z * s);
+    }
     /**
      * @brief Overrides / operator.
      * @param[in] v The Vector3 object you would like to divide to this Vector3
      * object
      * @return The Vector3 Object comprised of the division of the two objects
      */
-    Vector3 operator/(double s) const;
-    double operator*(const Vector3& v) const; //dot product
-    Vector3 cross(const Vector3& v) const;
-    double magnitude() const;
-    Vector3& normalize();
-    Vector3 unit() const; // normal vector in same direction
-    double dist(const Vector3& v) const;//distance between vectors
-    friend std::ostream& operator<<(std::ostream& strm, const Vector3& v);
+    constexpr Vector3 operator/(double s) const { return (*this) * (1 / s); }
+    constexpr double operator*(const Vector3& v) const {  // dot product
+      return x * v.x + y * v.y + z * v.z;
+    }
+    constexpr Vector3 cross(const Vector3& v) const {
+      return Vector3(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+    }
+    constexpr double magnitudeSquared() const { return (*this) * (*this); }
+    double magnitude() const { return std::sqrt(magnitudeSquared()); }
+    Vector3& normalize() {
+      normalizeAndLength();
+      return *this;
+    }
+    /**
+     * @brief Scales the vector to length 1, unless it is too short to have
+     * a direction.
+     * @return The length it had, so callers need not take the root twice
+     */
+    double normalizeAndLength() {
+      double length = magnitude();
+      if (length >= kEpsilon) *this = *this / length;
+      return length;
+    }
+    Vector3 unit() const {  // normal vector in same direction
+      Vector3 v = *this;
+      v.normalizeAndLength();
+      return v;
+    }
+    constexpr double distSquared(const Vector3& v) const {
+      return (x - v.x) * (x - v.x) + (y - v.y) * (y - v.y) +
+             (z - v.z) * (z - v.z);
+    }
+    double dist(const Vector3& v) const {  // distance between vectors
+      return std::sqrt(distSquared(v));
+    }
+    /**
+     * @brief Interpolates between this vector and another.
+     * @param[in] v Where to end up
+     * @param[in] t How far along, 0 for this vector and 1 for v
+     * @return The point that far along the line between them
+     */
+    constexpr Vector3 lerp(const Vector3& v, double t) const {
+      return Vector3(x + (v.x - x) * t, y + (v.y - y) * t, z + (v.z - z) * t);
+    }
+    friend std::ostream& operator<<(std::ostream& strm, const Vector3& v) {
+      strm << "[" << v.x << ", " << v.y << ", " << v.z << "]";
+      return strm;
+    }
+
+  private:
+    static constexpr double kEpsilon = 0.0000001;
+
+    [[noreturn]] static void outOfRange() {
+      throw std::out_of_range("i not in range for vector");
+    }
 };
 
 #endif
@@ -0,0 +1,97 @@
+#ifndef BLOCK_POOL_H_
+#define BLOCK_POOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+/**
+ * @class BlockPool
+ * @brief Recycles small fixed-size blocks, for objects that are created and
+ * destroyed all the time, such as movement strategies. Sizes are rounded up
+ * to a multiple of 16 bytes and each size keeps its own free list, so a
+ * freed block is reused by the next object of that size instead of going
+ * back to the heap. Blocks are carved from chunks that are kept for the
+ * life of the process, so long-running servers do not fragment the heap.
+ * Safe to use from any thread.
+ */
+class BlockPool {
+ public:
+  /**
+   * @return The pool shared by the whole process. It is never destroyed,
+   * so objects may be freed into it during static destruction.
+   */
+  static BlockPool& shared() {
+    static BlockPool* pool = new BlockPool();
+    return *pool;
+  }
+
+  /**
+   * @brief Takes a block
+   * @param size Bytes needed
+   * @return A block of at least size bytes, aligned for any object
+   */
+  void* allocate(std::size_t size) {
+    if (size > kLargest) return ::operator new(size);
+    SizeClass& sizeClass = classes[classOf(size)];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (!sizeClass.free) refill(sizeClass, (classOf(size) + 1) * kGranule);
+    FreeBlock* block = sizeClass.free;
+    sizeClass.free = block->next;
+    return block;
+  }
+
+  /**
+   * @brief Returns a block
+   * @param block Block from allocate
+   * @param size The size it was allocated with
+   */
+  void deallocate(void* block, std::size_t size) {
+    if (!block) return;
+    if (size > kLargest) {
+      ::operator delete(block);
+      return;
+    }
+    SizeClass& sizeClass = classes[classOf(size)];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = sizeClass.free;
+    sizeClass.free = freed;
+  }
+
+ private:
+  static const std::size_t kGranule = 16;
+  static const std::size_t kClasses = 16;
+  static const std::size_t kLargest = kGranule * kClasses;
+  static const int kBlocksPerChunk = 64;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct SizeClass {
+    std::mutex mutex;
+    FreeBlock* free = nullptr;
+  };
+
+  BlockPool() {}
+
+  static std::size_t classOf(std::size_t size) {
+    return size == 0 ? 0 : (size - 1) / kGranule;
+  }
+
+  // Threads a new chunk of blocks onto an empty free list.
+  static void refill(SizeClass& sizeClass, std::size_t blockSize) {
+    char* chunk =
+        static_cast<char*>(::operator new(blockSize * kBlocksPerChunk));
+    for (int i = kBlocksPerChunk - 1; i >= 0; i--) {
+      FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+      block->next = sizeClass.free;
+      sizeClass.free = block;
+    }
+  }
+
+  SizeClass classes[kClasses];
+};
+
+#endif
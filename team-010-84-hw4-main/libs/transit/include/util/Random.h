@@ -0,0 +1,53 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <cstdint>
+
+/**
+ * @class RandomStream
+ * @brief Counter-based random numbers: the nth draw of a stream is a hash
+ * of (seed, stream, n), so it depends on nothing but those three. Streams
+ * with the same seed and different ids are independent, and an entity that
+ * owns its stream draws the same numbers whichever thread updates it and
+ * whatever other entities do.
+ */
+class RandomStream {
+ public:
+  /**
+   * @brief Creates a stream
+   * @param seed Seed of the whole simulation
+   * @param stream Id of this stream within it
+   */
+  explicit RandomStream(uint64_t seed = 0, uint64_t stream = 0)
+      : key(mix(seed) ^ mix(stream + kGolden)) {}
+
+  /**
+   * @return The next 64 random bits
+   */
+  uint64_t next() { return mix(key + kGolden * ++counter); }
+
+  /**
+   * @param low Smallest value
+   * @param high Largest value
+   * @return The next number, uniformly distributed in [low, high)
+   */
+  double uniform(double low, double high) {
+    // the top 53 bits fill a double's mantissa exactly
+    return low + (high - low) * ((next() >> 11) * 0x1.0p-53);
+  }
+
+ private:
+  static constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+
+  // SplitMix64's finalizer
+  static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t key;
+  uint64_t counter = 0;
+};
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef SPATIAL_GRID_H_
+#define SPATIAL_GRID_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "math/float4.h"
+#include "math/vector3.h"
+
+/**
+ * @class SpatialGrid
+ * @brief Buckets points on the ground plane (x, z) into square cells so the
+ * nearest few can be found without looking at all of them. Points are
+ * identified by the index they were inserted with, which must be below 2^24.
+ *
+ * Each point is stored as one Float4, its position in x, y and z and its id
+ * in w, so a cell is a packed run of 16-byte records that the searches below
+ * scan without chasing anything.
+ */
+class SpatialGrid {
+ public:
+  /**
+   * @brief Creates an empty grid
+   * @param cellSize Side of a cell, roughly the spacing of the points
+   */
+  explicit SpatialGrid(double cellSize) : cellSize(cellSize) {}
+
+  /**
+   * @brief Adds a point
+   * @param id Index to report the point by
+   * @param position Where the point is; its height is ignored
+   */
+  void insert(int id, const Vector3& position) {
+    int cx = cellOf(position.x);
+    int cz = cellOf(position.z);
+    cells[key(cx, cz)].push_back(Float4(position, static_cast<float>(id)));
+    if (count++ == 0) {
+      minX = maxX = cx;
+      minZ = maxZ = cz;
+    } else {
+      minX = std::min(minX, cx);
+      maxX = std::max(maxX, cx);
+      minZ = std::min(minZ, cz);
+      maxZ = std::max(maxZ, cz);
+    }
+  }
+
+  /**
+   * @brief Finds the nearest points that pass a filter, searching outward
+   * one ring of cells at a time
+   * @param position Where to search from; its height is ignored
+   * @param k Most points to return
+   * @param accept Callable taking a point's id, false to skip the point
+   * @return Ids of up to k accepted points, nearest first
+   */
+  template <class F>
+  std::vector<int> nearest(const Vector3& position, int k, F accept) const {
+    std::vector<std::pair<double, int>> found;
+    if (count == 0 || k <= 0) return {};
+
+    Float4 from(position);
+    int cx = cellOf(position.x);
+    int cz = cellOf(position.z);
+    int maxRing = std::max(std::max(std::abs(cx - minX), std::abs(cx - maxX)),
+                           std::max(std::abs(cz - minZ), std::abs(cz - maxZ)));
+    for (int ring = 0; ring <= maxRing; ring++) {
+      // everything beyond this ring is at least this far away
+      double reach = (ring - 1) * cellSize;
+      if (found.size() >= k && reach > 0 && found[k - 1].first <= reach * reach) {
+        break;
+      }
+      for (int x = cx - ring; x <= cx + ring; x++) {
+        for (int z = cz - ring; z <= cz + ring; z++) {
+          if (std::abs(x - cx) != ring && std::abs(z - cz) != ring) continue;
+          auto cell = cells.find(key(x, z));
+          if (cell == cells.end()) continue;
+          for (const Float4& p : cell->second) {
+            int id = idOf(p);
+            if (!accept(id)) continue;
+            found.push_back({groundDistSquared(p, from), id});
+          }
+        }
+      }
+      std::sort(found.begin(), found.end());
+      if (found.size() > k) found.resize(k);
+    }
+
+    std::vector<int> ids;
+    for (const auto& f : found) ids.push_back(f.second);
+    return ids;
+  }
+
+  /**
+   * @brief Finds the point with the lowest cost, searching outward one ring
+   * of cells at a time until no farther point could cost less
+   * @param position Where to search from; its height is ignored
+   * @param cost Callable taking a point's id and its distance from
+   * position, returning a cost no less than that distance
+   * @return Id of the cheapest point, the lowest id among equals, or -1 if
+   * the grid is empty
+   */
+  template <class F>
+  int cheapest(const Vector3& position, F cost) const {
+    int best = -1;
+    double bestCost = std::numeric_limits<double>::infinity();
+    if (count == 0) return best;
+
+    Float4 from(position);
+    int cx = cellOf(position.x);
+    int cz = cellOf(position.z);
+    int maxRing = std::max(std::max(std::abs(cx - minX), std::abs(cx - maxX)),
+                           std::max(std::abs(cz - minZ), std::abs(cz - maxZ)));
+    for (int ring = 0; ring <= maxRing; ring++) {
+      // everything beyond this ring is at least this far away
+      double reach = (ring - 1) * cellSize;
+      if (best >= 0 && reach > 0 && bestCost <= reach) break;
+      for (int x = cx - ring; x <= cx + ring; x++) {
+        for (int z = cz - ring; z <= cz + ring; z++) {
+          if (std::abs(x - cx) != ring && std::abs(z - cz) != ring) continue;
+          auto cell = cells.find(key(x, z));
+          if (cell == cells.end()) continue;
+          for (const Float4& p : cell->second) {
+            int id = idOf(p);
+            double c = cost(id, std::sqrt(groundDistSquared(p, from)));
+            if (best < 0 || c < bestCost || (c == bestCost && id < best)) {
+              bestCost = c;
+              best = id;
+            }
+          }
+        }
+      }
+    }
+    return best;
+  }
+
+ private:
+  static int idOf(const Float4& point) { return static_cast<int>(point.w); }
+
+  static float groundDistSquared(const Float4& a, const Float4& b) {
+    float dx = a.x - b.x;
+    float dz = a.z - b.z;
+    return dx * dx + dz * dz;
+  }
+
+  int cellOf(double coordinate) const {
+    return static_cast<int>(std::floor(coordinate / cellSize));
+  }
+
+  static int64_t key(int x, int z) {
+    return (static_cast<int64_t>(x) << 32) ^ static_cast<uint32_t>(z);
+  }
+
+  double cellSize;
+  std::unordered_map<int64_t, std::vector<Float4>> cells;
+  int count = 0;
+  int minX = 0;
+  int maxX = 0;
+  int minZ = 0;
+  int maxZ = 0;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef TRIPLE_BUFFER_H_
+#define TRIPLE_BUFFER_H_
+
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Hands the latest value from one writer thread to one reader thread
+ * without locks. The writer fills the back buffer and publishes it; the
+ * reader picks up the newest published buffer. Neither ever waits for the
+ * other, and the reader may skip values if the writer is faster.
+ */
+template <class T>
+class TripleBuffer {
+ public:
+  /**
+   * @brief Writer side: buffer to fill before the next publish. It still
+   * holds whatever it held when last handed back, so it can be reused.
+   * @return The back buffer
+   */
+  T& back() { return buffers[backIndex]; }
+
+  /**
+   * @brief Writer side: makes the back buffer the newest value and takes
+   * another buffer as the new back buffer
+   */
+  void publish() {
+    int old = middle.exchange(backIndex | kFresh, std::memory_order_acq_rel);
+    backIndex = old & kIndexMask;
+  }
+
+  /**
+   * @brief Reader side: moves to the newest published value, if there is
+   * one the reader has not seen
+   * @return Whether front now holds a new value
+   */
+  bool update() {
+    if (!(middle.load(std::memory_order_acquire) & kFresh)) return false;
+    int old = middle.exchange(frontIndex, std::memory_order_acq_rel);
+    frontIndex = old & kIndexMask;
+    return true;
+  }
+
+  /**
+   * @brief Reader side: the value picked up by the last update
+   * @return The front buffer
+   */
+  const T& front() const { return buffers[frontIndex]; }
+
+ private:
+  static const int kIndexMask = 3;
+  static const int kFresh = 4;
+
+  T buffers[3];
+  int backIndex = 0;
+  std::atomic<int> middle{1};
+  int frontIndex = 2;
+};
+
+#endif
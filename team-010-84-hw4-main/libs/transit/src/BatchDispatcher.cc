@@ -0,0 +1,222 @@
+#include "BatchDispatcher.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "SimulationModel.h"
+#include "util/SpatialGrid.h"
+
+namespace {
+
+// Batch the oldest packages, enough to give each drone a choice, so work per
+// dispatch stays bounded and no package waits behind ever newer ones.
+const int kWindowPerDrone = 4;
+const int kMinWindow = 64;
+
+// Added to drones that must recharge first, so any drone that can leave now
+// is preferred; larger than any real trip time.
+const double kWaitingPenalty = 1e6;
+
+struct Edge {
+  int column;
+  double cost;
+};
+
+// Minimum cost matching of rows to columns over a sparse set of edges,
+// by successive shortest augmenting paths (the Hungarian method with
+// Dijkstra and potentials). Rows are matched in order and, once matched,
+// are only ever moved to another column, never dropped, so when columns
+// run out the earlier rows keep theirs. A search that finds no free column
+// has found a closed set of columns no later path can leave, so those
+// columns are skipped from then on. Returns the column of each row, or -1.
+std::vector<int> solveAssignment(const std::vector<std::vector<Edge>>& edges,
+                                 int cols) {
+  const double inf = std::numeric_limits<double>::infinity();
+  int rows = edges.size();
+  std::vector<double> u(rows, 0), v(cols, 0);
+  std::vector<int> columnOfRow(rows, -1), rowOfColumn(cols, -1);
+  std::vector<double> dist(cols, inf);
+  std::vector<int> pred(cols, -1);
+  std::vector<bool> settled(cols, false);
+  std::vector<bool> dead(cols, false);
+  std::vector<int> touched;
+  typedef std::pair<double, int> Entry;
+
+  for (int r = 0; r < rows; r++) {
+    if (edges[r].empty()) continue;
+    // start the row tight against its cheapest edge
+    u[r] = inf;
+    for (const Edge& e : edges[r]) u[r] = std::min(u[r], e.cost - v[e.column]);
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    auto relax = [&](int row, double base) {
+      for (const Edge& e : edges[row]) {
+        if (dead[e.column] || settled[e.column]) continue;
+        double d = base + e.cost - u[row] - v[e.column];
+        if (d < dist[e.column]) {
+          if (dist[e.column] == inf) touched.push_back(e.column);
+          dist[e.column] = d;
+          pred[e.column] = row;
+          queue.push({d, e.column});
+        }
+      }
+    };
+    relax(r, 0);
+
+    int sink = -1;
+    std::vector<int> done;
+    while (!queue.empty()) {
+      Entry top = queue.top();
+      queue.pop();
+      int c = top.second;
+      if (settled[c] || top.first > dist[c]) continue;
+      if (rowOfColumn[c] < 0) {
+        sink = c;
+        break;
+      }
+      settled[c] = true;
+      done.push_back(c);
+      relax(rowOfColumn[c], dist[c]);
+    }
+
+    if (sink >= 0) {
+      // shift potentials so the path is tight, then flip it
+      double length = dist[sink];
+      for (int c : done) {
+        v[c] -= length - dist[c];
+        u[rowOfColumn[c]] += length - dist[c];
+      }
+      u[r] += length;
+      for (int c = sink; c >= 0;) {
+        int row = pred[c];
+        int previous = columnOfRow[row];
+        columnOfRow[row] = c;
+        rowOfColumn[c] = row;
+        c = row == r ? -1 : previous;
+      }
+    } else {
+      for (int c : done) dead[c] = true;
+    }
+
+    for (int c : touched) {
+      dist[c] = inf;
+      pred[c] = -1;
+      settled[c] = false;
+    }
+    touched.clear();
+  }
+  return columnOfRow;
+}
+
+}  // namespace
+
+BatchDispatcher::BatchDispatcher(int candidatesPerPackage, double cellSize)
+    : candidatesPerPackage(candidatesPerPackage), cellSize(cellSize) {}
+
+void BatchDispatcher::dispatch(SimulationModel& model,
+                               std::deque<Package*>& pending) {
+  const EntityStore& entities = model.getEntities();
+  if (pending.empty() || entities.availableCount() == 0) return;
+
+  std::vector<Drone*> drones;
+  SpatialGrid grid(cellSize);
+  for (const auto& weightClass : entities.availableDrones()) {
+    for (Drone* d : weightClass.second) {
+      grid.insert(drones.size(), d->getPosition());
+      drones.push_back(d);
+    }
+  }
+  int window = std::min<int>(
+      pending.size(), std::max<int>(kMinWindow, kWindowPerDrone * drones.size()));
+
+  // sparse candidate pairs: each package and its nearest capable drones
+  std::vector<std::vector<Edge>> edges;
+  std::vector<std::vector<double>> distances;  // parallel to edges
+  std::vector<int> packageOfRow;
+  std::vector<ChargingStation*> stationOfRow;
+  std::vector<int> droneOfColumn;
+  std::vector<int> columnOfDrone(drones.size(), -1);
+  // charging the batch has already sent each station's way, so packages
+  // bound for the same area spread over its stations
+  std::unordered_map<ChargingStation*, StationLoad> tentative;
+  std::vector<DeliveryQuote> quotes(drones.size());
+  for (int i = 0; i < window; i++) {
+    Package* package = pending[i];
+    ChargingStation* endStation =
+        model.getBestRechargeStation(package->getDestination(),
+                                     kStationSpeed, &tentative);
+    if (!endStation) continue;
+
+    std::vector<int> nearest = grid.nearest(
+        package->getPosition(), candidatesPerPackage, [&](int d) {
+          quotes[d] = IDispatcher::quote(drones[d], package, endStation);
+          return quotes[d].feasible;
+        });
+    if (nearest.empty()) continue;
+
+    // the drone is not known yet, so count the trip from the package on
+    StationLoad& load = tentative[endStation];
+    load.drones++;
+    load.deficit +=
+        package->getPosition().dist(package->getDestination()) +
+        package->getDestination().dist(endStation->getPosition());
+
+    packageOfRow.push_back(i);
+    stationOfRow.push_back(endStation);
+    edges.emplace_back();
+    distances.emplace_back();
+    for (int d : nearest) {
+      if (columnOfDrone[d] < 0) {
+        columnOfDrone[d] = droneOfColumn.size();
+        droneOfColumn.push_back(d);
+      }
+      const DeliveryQuote& q = quotes[d];
+      edges.back().push_back(
+          {columnOfDrone[d], q.time + (q.ready ? 0 : kWaitingPenalty)});
+      distances.back().push_back(q.distance);
+    }
+  }
+  if (edges.empty()) return;
+
+  // match from the smaller side, so that side is matched in full and the
+  // total cost is minimal
+  int packageCount = packageOfRow.size();
+  int droneCount = droneOfColumn.size();
+  std::vector<int> droneOfPackageRow(packageCount, -1);
+  if (packageCount <= droneCount) {
+    droneOfPackageRow = solveAssignment(edges, droneCount);
+  } else {
+    std::vector<std::vector<Edge>> packagesOfDrone(droneCount);
+    for (int row = 0; row < packageCount; row++) {
+      for (const Edge& e : edges[row]) {
+        packagesOfDrone[e.column].push_back({row, e.cost});
+      }
+    }
+    std::vector<int> rowOfDrone = solveAssignment(packagesOfDrone, packageCount);
+    for (int column = 0; column < droneCount; column++) {
+      if (rowOfDrone[column] >= 0) droneOfPackageRow[rowOfDrone[column]] = column;
+    }
+  }
+
+  // hand out deliveries oldest first, then keep the rest in order
+  std::vector<bool> assigned(window, false);
+  for (int row = 0; row < packageCount; row++) {
+    int column = droneOfPackageRow[row];
+    if (column < 0) continue;
+    Package* package = pending[packageOfRow[row]];
+    Drone* drone = drones[droneOfColumn[column]];
+    int e = 0;
+    while (edges[row][e].column != column) e++;
+    drone->setNextDelivery(package, distances[row][e], stationOfRow[row]);
+    assigned[packageOfRow[row]] = true;
+  }
+  std::deque<Package*> remaining;
+  for (int i = 0; i < pending.size(); i++) {
+    if (i >= window || !assigned[i]) remaining.push_back(pending[i]);
+  }
+  pending.swap(remaining);
+}
@@ -1,14 +1,17 @@
 #include "BeelineStrategy.h"
 
-BeelineStrategy::BeelineStrategy(Vector3 pos, Vector3 des): PathStrategy({
-    {
-      static_cast<float>(pos[0]),
-      static_cast<float>(pos[1]),
-      static_cast<float>(pos[2])
-    },
-    {
-      static_cast<float>(des[0]),
-      static_cast<float>(des[1]),
-      static_cast<float>(des[2])
-    }
-  }) {}
+namespace {
+
+std::shared_ptr<const routing::WaypointBuffer> line(Vector3 pos, Vector3 des) {
+  std::shared_ptr<routing::WaypointBuffer> points =
+      std::make_shared<routing::WaypointBuffer>();
+  points->Reserve(2);
+  points->Append(pos.x, pos.y, pos.z);
+  points->Append(des.x, des.y, des.z);
+  return points;
+}
+
+}  // namespace
+
+BeelineStrategy::BeelineStrategy(Vector3 pos, Vector3 des)
+  : PathStrategy(line(pos, des)) {}
@@ -13,5 +13,5 @@ BfsStrategy::BfsStrategy(Vector3 pos, Vector3 des,
     static_cast<float>(des[1]),
     static_cast<float>(des[2])
   };
-  path = g->GetPath(start, end, routing::BreadthFirstSearch::Default());
+  path = g->GetRoute(start, end, routing::BreadthFirstSearch::Default());
 }
@@ -1,55 +1,109 @@
 #include "ChargingStation.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "SimulationModel.h"
+
 ChargingStation::ChargingStation(JsonObject& obj) : IEntity(obj) {
-  slotsAvailible = obj["slots"];
+  int slots = obj["slots"];
   chargeRate = obj["charge_speed"];
-  droneCurCharge.assign(slotsAvailible, nullptr);
+  droneCurCharge.assign(slots, nullptr);
+  fullAt.assign(slots, 0);
+  // hand out the lowest slots first
+  for (int i = slots - 1; i >= 0; i--) freeSlots.push_back(i);
 }
 
 ChargingStation::~ChargingStation() {}
 
 void ChargingStation::update(double dt) {
-  rechargeDrone(dt);
-  while (slotsAvailible > 0) {
-    if (droneQueue.size() == 0) return;
-    for (int i = 0; i < droneCurCharge.size(); i++) {
-      if (droneCurCharge.at(i) == nullptr) {
-        droneCurCharge.at(i) = droneQueue.front();
-        break;
-      }
+  double now = model ? model->getTime() : 0;
+  while (!completions.empty() && completions.top().first <= now) {
+    Completion due = completions.top();
+    completions.pop();
+    if (droneCurCharge[due.second] && fullAt[due.second] == due.first) {
+      unplug(due.second);
     }
-    droneQueue.pop();
-    slotsAvailible -= 1;
   }
-  return;
+  admit();
 }
 
-void ChargingStation::rechargeDrone(double dt) {
-  for (int i = 0; i < droneCurCharge.size(); i++) {
-    Drone* drone = droneCurCharge.at(i);
-    if (!drone) continue;
-    if (drone->getBatteryCapacity() >
-        static_cast<int>(drone->getBatteryCharge())) {
-      drone->recharge(static_cast<double>(chargeRate) * dt);
-    } else {
-      unplugDrone(drone);
+void ChargingStation::queueUp(Drone* drone) {
+  for (auto i = inbound.begin(); i != inbound.end(); ++i) {
+    if (i->first == drone) {
+      inbound.erase(i);
+      break;
     }
   }
+  droneQueue.push_back(drone);
+  admit();
+}
+
+void ChargingStation::expect(Drone* drone, double deficit) {
+  inbound.push_back({drone, deficit});
 }
 
-void ChargingStation::queueUp(Drone* drone) { droneQueue.push(drone); }
+double ChargingStation::estimatedWait(const StationLoad& extra) const {
+  int slots = droneCurCharge.size();
+  int plugged = slots - freeSlots.size();
+  int coming = droneQueue.size() + inbound.size() + extra.drones;
+  if (plugged + coming < slots) return 0;
+  if (slots == 0 || chargeRate <= 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  double owed = 0;
+  for (Drone* drone : droneCurCharge) {
+    if (drone) owed += drone->getBatteryCapacity() - drone->getBatteryCharge();
+  }
+  for (Drone* drone : droneQueue) {
+    owed += drone->getBatteryCapacity() - drone->getBatteryCharge();
+  }
+  for (const auto& expected : inbound) owed += expected.second;
+  owed += extra.deficit;
+  return owed / (static_cast<double>(slots) * chargeRate);
+}
 
 void ChargingStation::unplugDrone(Drone* drone) {
   for (int i = 0; i < droneCurCharge.size(); i++) {
-    if (droneCurCharge.at(i) == drone) {
-      if (droneQueue.size() == 0) {
-        droneCurCharge.at(i) = nullptr;
-        slotsAvailible += 1;
-        return;
-      }
-      droneCurCharge.at(i) = droneQueue.front();
-      droneQueue.pop();
+    if (droneCurCharge[i] == drone) {
+      unplug(i);
+      admit();
       return;
     }
   }
+  // dispatched while still waiting for a slot
+  auto queued = std::find(droneQueue.begin(), droneQueue.end(), drone);
+  if (queued != droneQueue.end()) droneQueue.erase(queued);
+}
+
+void ChargingStation::plugIn(Drone* drone, int slot) {
+  double now = model ? model->getTime() : 0;
+  drone->startCharging(chargeRate);
+  droneCurCharge[slot] = drone;
+  if (model) model->chargingChanged(1);
+  if (chargeRate <= 0) {
+    fullAt[slot] = std::numeric_limits<double>::infinity();
+    return;
+  }
+  double missing = drone->getBatteryCapacity() - drone->getBatteryCharge();
+  fullAt[slot] = now + std::max(0.0, missing) / chargeRate;
+  completions.push({fullAt[slot], slot});
+  if (model) model->wakeAt(this, fullAt[slot]);
+}
+
+void ChargingStation::unplug(int slot) {
+  droneCurCharge[slot]->stopCharging();
+  droneCurCharge[slot] = nullptr;
+  freeSlots.push_back(slot);
+  if (model) model->chargingChanged(-1);
+}
+
+void ChargingStation::admit() {
+  while (!freeSlots.empty() && !droneQueue.empty()) {
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    plugIn(droneQueue.front(), slot);
+    droneQueue.pop_front();
+  }
 }
@@ -0,0 +1,79 @@
+#include "DeliveryLog.h"
+
+#include <algorithm>
+
+namespace {
+
+// {count, mean, p50, p95, max} of a set of durations.
+JsonObject distribution(std::vector<double> values) {
+  JsonObject result;
+  result["count"] = static_cast<int>(values.size());
+  if (values.empty()) return result;
+
+  std::sort(values.begin(), values.end());
+  double sum = 0;
+  for (double v : values) sum += v;
+  auto quantile = [&](double q) {
+    return values[static_cast<int>(q * (values.size() - 1) + 0.5)];
+  };
+  result["mean"] = sum / values.size();
+  result["p50"] = quantile(0.5);
+  result["p95"] = quantile(0.95);
+  result["max"] = values.back();
+  return result;
+}
+
+}  // namespace
+
+void DeliveryLog::scheduled(int package, const std::string& name,
+                            double time) {
+  recordOf[package] = records.size();
+  DeliveryRecord record;
+  record.package = package;
+  record.name = name;
+  record.scheduled = time;
+  records.push_back(record);
+}
+
+void DeliveryLog::assigned(int package, double time) {
+  DeliveryRecord* record = find(package);
+  if (record && record->assigned < 0) record->assigned = time;
+}
+
+void DeliveryLog::delivered(int package, double time) {
+  DeliveryRecord* record = find(package);
+  if (record && record->delivered < 0) {
+    record->delivered = time;
+    deliveredCount++;
+  }
+}
+
+DeliveryRecord* DeliveryLog::find(int package) {
+  auto found = recordOf.find(package);
+  return found == recordOf.end() ? nullptr : &records[found->second];
+}
+
+JsonObject DeliveryLog::summary(double time) const {
+  std::vector<double> waits;
+  std::vector<double> latencies;
+  int assignedCount = 0;
+  for (const DeliveryRecord& record : records) {
+    if (record.assigned >= 0) {
+      assignedCount++;
+      waits.push_back(record.assigned - record.scheduled);
+    }
+    if (record.delivered >= 0) {
+      latencies.push_back(record.delivered - record.scheduled);
+    }
+  }
+
+  JsonObject result;
+  result["scheduled"] = static_cast<int>(records.size());
+  result["assigned"] = assignedCount;
+  result["delivered"] = deliveredCount;
+  result["outstanding"] = outstanding();
+  result["perHour"] = time > 0 ? deliveredCount * 3600.0 / time : 0.0;
+  result["waitForDrone"] = distribution(waits);
+  result["latency"] = distribution(latencies);
+  return result;
+}
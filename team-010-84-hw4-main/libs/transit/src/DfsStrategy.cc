@@ -13,5 +13,5 @@ DfsStrategy::DfsStrategy(Vector3 pos, Vector3 des,
     static_cast<float>(des[1]),
     static_cast<float>(des[2])
   };
-  path = g->GetPath(start, end, routing::DepthFirstSearch::Default());
+  path = g->GetRoute(start, end, routing::DepthFirstSearch::Default());
 }
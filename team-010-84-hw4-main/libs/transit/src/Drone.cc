@@ -1,19 +1,21 @@
 #define _USE_MATH_DEFINES
 #include "Drone.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
 #include "AstarStrategy.h"
 #include "BeelineStrategy.h"
 #include "BfsStrategy.h"
+#include "CelebrationStrategy.h"
 #include "ChargingStation.h"
 #include "DfsStrategy.h"
 #include "DijkstraStrategy.h"
-#include "JumpDecorator.h"
+#include "JumpCelebration.h"
 #include "Package.h"
 #include "SimulationModel.h"
-#include "SpinDecorator.h"
+#include "SpinCelebration.h"
 
 Drone::Drone(JsonObject& obj) : IEntity(obj) {
   available = true;
@@ -23,22 +25,24 @@ Drone::Drone(JsonObject& obj) : IEntity(obj) {
   // std::cout << "Finished constructor\n";
 }
 
-Drone::~Drone() {
-  if (toPackage) delete toPackage;
-  if (toFinalDestination) delete toFinalDestination;
-  if (package) delete package;
-  if (rechargeStation) delete rechargeStation;
-}
+Drone::~Drone() {}
 
 void Drone::setNextDelivery(Package* package1, double chargeRequired,
                             ChargingStation* endStation) {
   package = package1;                // store package
   nextChargingStation = endStation;  // store charging station
-  rechargeStation =
-      new BeelineStrategy(package->getDestination(), endStation->getPosition());
+  rechargeStation.reset(
+      new BeelineStrategy(package->getDestination(), endStation->getPosition()));
   //
   if (package) {  // package exists
     available = false;
+    model->setDroneAvailable(this, false);
+    model->wake(this);
+    model->packageAssigned(package);
+    // the charge the trip will leave it short of when it reaches the station
+    double deficit = batteryCapacity - batteryCharge + chargeRequired;
+    endStation->expect(this, std::max(0.0, std::min<double>(deficit,
+                                                            batteryCapacity)));
     pickedUp = false;
     //
     this->chargeRequired = chargeRequired;
@@ -46,25 +50,33 @@ void Drone::setNextDelivery(Package* package1, double chargeRequired,
     Vector3 packagePosition = package->getPosition();
     Vector3 finalDestination = package->getDestination();
 
-    toPackage = new BeelineStrategy(position, packagePosition);
+    toPackage.reset(new BeelineStrategy(position, packagePosition));
 
     std::string strat = package->getStrategyName();
+    const routing::IGraph* graph = model->getGraph();
+    // each route ends in its own celebration, performed in the order listed
     if (strat == "astar") {
-      toFinalDestination = new JumpDecorator(new AstarStrategy(
-          packagePosition, finalDestination, model->getGraph()));
+      toFinalDestination.reset(new CelebrationStrategy<JumpCelebration>(
+          AstarStrategy(packagePosition, finalDestination, graph),
+          JumpCelebration()));
     } else if (strat == "dfs") {
-      toFinalDestination = new SpinDecorator(new JumpDecorator(new DfsStrategy(
-          packagePosition, finalDestination, model->getGraph())));
+      toFinalDestination.reset(
+          new CelebrationStrategy<JumpCelebration, SpinCelebration>(
+              DfsStrategy(packagePosition, finalDestination, graph),
+              JumpCelebration(), SpinCelebration()));
     } else if (strat == "bfs") {
-      toFinalDestination = new SpinDecorator(new SpinDecorator(new BfsStrategy(
-          packagePosition, finalDestination, model->getGraph())));
+      toFinalDestination.reset(
+          new CelebrationStrategy<SpinCelebration, SpinCelebration>(
+              BfsStrategy(packagePosition, finalDestination, graph),
+              SpinCelebration(), SpinCelebration()));
     } else if (strat == "dijkstra") {
-      toFinalDestination =
-          new JumpDecorator(new SpinDecorator(new DijkstraStrategy(
-              packagePosition, finalDestination, model->getGraph())));
+      toFinalDestination.reset(
+          new CelebrationStrategy<SpinCelebration, JumpCelebration>(
+              DijkstraStrategy(packagePosition, finalDestination, graph),
+              SpinCelebration(), JumpCelebration()));
     } else {
-      toFinalDestination =
-          new BeelineStrategy(packagePosition, finalDestination);
+      toFinalDestination.reset(
+          new BeelineStrategy(packagePosition, finalDestination));
     }
   }
 }
@@ -73,56 +85,96 @@ void Drone::update(double dt) {
   // std::cout << "Entering update loop\n";
   if (starting && model) {
     nextChargingStation = model->getClosestRechargeStation(getPosition());
-    rechargeStation =
-        new BeelineStrategy(position, nextChargingStation->getPosition());
+    rechargeStation.reset(
+        new BeelineStrategy(position, nextChargingStation->getPosition()));
 
     starting = false;
     // std::cout << "This thing done succesfully\n";
   }
-  // currently moving to package
-  if (toPackage && batteryCharge > chargeRequired) {
-    toPackage->move(this, dt);
-    batteryCharge -= (speed * dt);
-    // charge has already been guaranteed, and can be disregarded moving forward
-    if (chargeRequired != 0) {
-      nextChargingStation->unplugDrone(this);
+  // each leg takes what it needs of dt and leaves the rest to the next;
+  // the battery drains only for the time spent on a leg
+  double left = dt;
+  while (left > 0) {
+    if (toPackage && getBatteryCharge() > chargeRequired) {
+      // currently moving to package
+      // leaving the station, which unplugs the drone in the commit phase
+      stopCharging();
+      double unused = toPackage->move(this, left);
+      batteryCharge -= speed * (left - unused);
+      left = unused;
+      // charge has already been guaranteed, and can be disregarded moving
+      // forward
       chargeRequired = 0.0;
-    }
-    if (toPackage->isCompleted()) {
-      delete toPackage;
-      toPackage = nullptr;
-      pickedUp = true;
-    }
-  } else if (toFinalDestination) {  // currently moving to final destination
-    toFinalDestination->move(this, dt);
-    batteryCharge -= (speed * dt);
-    if (package && pickedUp) {
-      package->setPosition(position);
-      package->setDirection(direction);
-    }
-    if (toFinalDestination->isCompleted()) {  // reached final destination
-      delete toFinalDestination;
-      toFinalDestination = nullptr;
-      package->handOff();
-      package = nullptr;
-      pickedUp = false;
-    }
-  } else if (rechargeStation) {
-    rechargeStation->move(this, dt);
-    batteryCharge -= (speed * dt);
-    if (rechargeStation->isCompleted()) {
-      // std::cout << "path completed\n";
-      available = true;
-      delete rechargeStation;
-      rechargeStation = nullptr;
-      nextChargingStation->queueUp(this);
-      // std::cout << "completed\n";
+      if (dockedAt) {
+        ChargingStation* station = dockedAt;
+        dockedAt = nullptr;
+        model->defer([this, station] { station->unplugDrone(this); });
+      }
+      if (toPackage->isCompleted()) {
+        toPackage.reset();
+        pickedUp = true;
+        if (package) {
+          Package* carried = package;
+          model->defer([carried] { carried->pickUp(); });
+        }
+      }
+    } else if (toFinalDestination) {  // currently moving to final destination
+      double unused = toFinalDestination->move(this, left);
+      batteryCharge -= speed * (left - unused);
+      left = unused;
+      if (package && pickedUp) {
+        Package* carried = package;
+        Vector3 pos = position;
+        Vector3 dir = direction;
+        model->defer([carried, pos, dir] {
+          carried->setPosition(pos);
+          carried->setDirection(dir);
+        });
+      }
+      if (toFinalDestination->isCompleted()) {  // reached final destination
+        toFinalDestination.reset();
+        Package* delivered = package;
+        model->defer([delivered] { delivered->handOff(); });
+        package = nullptr;
+        pickedUp = false;
+      }
+    } else if (rechargeStation) {
+      double unused = rechargeStation->move(this, left);
+      batteryCharge -= speed * (left - unused);
+      left = unused;
+      if (rechargeStation->isCompleted()) {
+        // std::cout << "path completed\n";
+        available = true;
+        rechargeStation.reset();
+        ChargingStation* station = nextChargingStation;
+        dockedAt = station;
+        model->defer([this, station] {
+          model->setDroneAvailable(this, true);
+          station->queueUp(this);
+        });
+        // std::cout << "completed\n";
+      }
+    } else {
+      break;
     }
   }
   // std::cout << "Battery charge: " << batteryCharge << "\n";
 }
 
-void Drone::recharge(const double amount) { batteryCharge += amount; }
+bool Drone::isIdle() const {
+  return !starting && !toPackage && !toFinalDestination && !rechargeStation;
+}
+
+void Drone::startCharging(double rate) {
+  stopCharging();
+  chargeRate = rate;
+  chargingSince = model ? model->getTime() : 0;
+}
+
+void Drone::stopCharging() {
+  batteryCharge = getBatteryCharge();
+  chargeRate = 0;
+}
 
 bool Drone::getAvailability() { return available; }
 
@@ -130,4 +182,8 @@ int Drone::getWeight() { return weightCapacity; }
 
 int Drone::getBatteryCapacity() { return batteryCapacity; }
 
-double Drone::getBatteryCharge() { return batteryCharge; }
+double Drone::getBatteryCharge() {
+  if (chargeRate <= 0 || !model) return batteryCharge;
+  double charged = chargeRate * (model->getTime() - chargingSince);
+  return std::min<double>(batteryCapacity, batteryCharge + charged);
+}
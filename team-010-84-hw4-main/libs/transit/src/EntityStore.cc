@@ -0,0 +1,280 @@
+#include "EntityStore.h"
+
+#include <algorithm>
+
+namespace {
+
+// Removes the first copy of value, keeping the rest in order. The vectors
+// this is used on hold entities sharing one name, so they stay short.
+template <class T>
+void eraseValue(std::vector<T*>& items, const T* value) {
+  auto found = std::find(items.begin(), items.end(), value);
+  if (found != items.end()) items.erase(found);
+}
+
+// Erases an empty vector from a map of vectors.
+template <class Map, class Key>
+void eraseIfEmpty(Map& map, const Key& key) {
+  auto found = map.find(key);
+  if (found != map.end() && found->second.empty()) map.erase(found);
+}
+
+}  // namespace
+
+template <class T>
+int EntityStore::insert(DenseArray<T>& array, T* item, int slot) {
+  array.items.push_back(item);
+  array.slots.push_back(slot);
+  return array.items.size() - 1;
+}
+
+template <class T>
+void EntityStore::erase(DenseArray<T>& array, int dense, int Slot::*index) {
+  int last = array.items.size() - 1;
+  if (dense != last) {
+    array.items[dense] = array.items[last];
+    array.slots[dense] = array.slots[last];
+    slots[array.slots[dense]].*index = dense;
+  }
+  array.items.pop_back();
+  array.slots.pop_back();
+}
+
+EntityHandle EntityStore::add(IEntity* entity) {
+  int slot;
+  if (freeSlots.empty()) {
+    slot = slots.size();
+    slots.emplace_back();
+  } else {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+  }
+
+  Slot& s = slots[slot];
+  s.entity = entity;
+  s.kind = entity->getKind();
+  // the kind tag makes these casts safe without dynamic_cast
+  switch (s.kind) {
+    case EntityKind::Drone:
+      s.dense = insert(droneArray, static_cast<Drone*>(entity), slot);
+      break;
+    case EntityKind::Package:
+      s.dense = insert(packageArray, static_cast<Package*>(entity), slot);
+      break;
+    case EntityKind::Robot:
+      s.dense = insert(robotArray, static_cast<Robot*>(entity), slot);
+      break;
+    case EntityKind::ChargingStation:
+      s.dense = insert(stationArray, static_cast<ChargingStation*>(entity),
+                       slot);
+      break;
+    default:
+      s.dense = insert(otherArray, entity, slot);
+      break;
+  }
+  slotById[entity->getId()] = slot;
+  index(entity);
+  setAwake(entity, true);
+
+  EntityHandle handle;
+  handle.index = slot;
+  handle.generation = s.generation;
+  return handle;
+}
+
+IEntity* EntityStore::remove(int id) {
+  auto found = slotById.find(id);
+  if (found == slotById.end()) return nullptr;
+  int slot = found->second;
+  Slot& s = slots[slot];
+  IEntity* entity = s.entity;
+  setAwake(entity, false);
+  slotById.erase(found);
+  unindex(entity);
+  switch (s.kind) {
+    case EntityKind::Drone:
+      erase(droneArray, s.dense, &Slot::dense);
+      break;
+    case EntityKind::Package:
+      erase(packageArray, s.dense, &Slot::dense);
+      break;
+    case EntityKind::Robot:
+      erase(robotArray, s.dense, &Slot::dense);
+      break;
+    case EntityKind::ChargingStation:
+      erase(stationArray, s.dense, &Slot::dense);
+      break;
+    default:
+      erase(otherArray, s.dense, &Slot::dense);
+      break;
+  }
+
+  s.entity = nullptr;
+  s.dense = -1;
+  s.generation++;
+  freeSlots.push_back(slot);
+  return entity;
+}
+
+IEntity* EntityStore::get(int id) const {
+  auto found = slotById.find(id);
+  return found == slotById.end() ? nullptr : slots[found->second].entity;
+}
+
+IEntity* EntityStore::get(EntityHandle handle) const {
+  if (handle.index < 0 || handle.index >= slots.size()) return nullptr;
+  const Slot& s = slots[handle.index];
+  return s.generation == handle.generation ? s.entity : nullptr;
+}
+
+EntityHandle EntityStore::handleOf(int id) const {
+  EntityHandle handle;
+  auto found = slotById.find(id);
+  if (found != slotById.end()) {
+    handle.index = found->second;
+    handle.generation = slots[found->second].generation;
+  }
+  return handle;
+}
+
+const std::vector<IEntity*>& EntityStore::named(const std::string& name) const {
+  static const std::vector<IEntity*> none;
+  auto found = byName.find(name);
+  return found == byName.end() ? none : found->second;
+}
+
+Robot* EntityStore::openRequest(const std::string& name) const {
+  auto found = openRobots.find(name);
+  return found == openRobots.end() ? nullptr : found->second.front();
+}
+
+Package* EntityStore::openPackage(const std::string& name) const {
+  auto found = openPackages.find(name);
+  return found == openPackages.end() ? nullptr : found->second.front();
+}
+
+void EntityStore::closeRequest(Robot* robot, Package* package) {
+  if (robot) {
+    eraseValue(openRobots[robot->getName()], robot);
+    eraseIfEmpty(openRobots, robot->getName());
+  }
+  if (package) {
+    eraseValue(openPackages[package->getName()], package);
+    eraseIfEmpty(openPackages, package->getName());
+  }
+}
+
+void EntityStore::setAvailable(Drone* drone, bool available) {
+  auto found = availableSlot.find(drone);
+  if (available == (found != availableSlot.end())) return;
+
+  std::vector<Drone*>& weightClass = availableByWeight[drone->getWeight()];
+  if (available) {
+    availableSlot[drone] = weightClass.size();
+    weightClass.push_back(drone);
+    return;
+  }
+
+  int dense = found->second;
+  availableSlot.erase(found);
+  if (dense != weightClass.size() - 1) {
+    weightClass[dense] = weightClass.back();
+    availableSlot[weightClass[dense]] = dense;
+  }
+  weightClass.pop_back();
+  if (weightClass.empty()) availableByWeight.erase(drone->getWeight());
+}
+
+void EntityStore::setAwake(IEntity* entity, bool awake) {
+  auto found = slotById.find(entity->getId());
+  if (found == slotById.end()) return;
+  int slot = found->second;
+  Slot& s = slots[slot];
+  if (awake == (s.awake >= 0)) return;
+
+  switch (s.kind) {
+    case EntityKind::Drone:
+      if (awake) {
+        s.awake = insert(awakeDroneArray, static_cast<Drone*>(entity), slot);
+      } else {
+        erase(awakeDroneArray, s.awake, &Slot::awake);
+      }
+      break;
+    case EntityKind::Package:
+      if (awake) {
+        s.awake =
+            insert(awakePackageArray, static_cast<Package*>(entity), slot);
+      } else {
+        erase(awakePackageArray, s.awake, &Slot::awake);
+      }
+      break;
+    case EntityKind::Robot:
+      if (awake) {
+        s.awake = insert(awakeRobotArray, static_cast<Robot*>(entity), slot);
+      } else {
+        erase(awakeRobotArray, s.awake, &Slot::awake);
+      }
+      break;
+    case EntityKind::ChargingStation:
+      if (awake) {
+        s.awake = insert(awakeStationArray,
+                         static_cast<ChargingStation*>(entity), slot);
+      } else {
+        erase(awakeStationArray, s.awake, &Slot::awake);
+      }
+      break;
+    default:
+      if (awake) {
+        s.awake = insert(awakeOtherArray, entity, slot);
+      } else {
+        erase(awakeOtherArray, s.awake, &Slot::awake);
+      }
+      break;
+  }
+  if (!awake) s.awake = -1;
+}
+
+void EntityStore::index(IEntity* entity) {
+  byName[entity->getName()].push_back(entity);
+  switch (entity->getKind()) {
+    case EntityKind::Drone: {
+      Drone* drone = static_cast<Drone*>(entity);
+      setAvailable(drone, drone->getAvailability());
+      break;
+    }
+    case EntityKind::Package: {
+      Package* package = static_cast<Package*>(entity);
+      if (package->requiresDelivery) {
+        openPackages[package->getName()].push_back(package);
+      }
+      break;
+    }
+    case EntityKind::Robot: {
+      Robot* robot = static_cast<Robot*>(entity);
+      if (robot->requestedDelivery) {
+        openRobots[robot->getName()].push_back(robot);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void EntityStore::unindex(IEntity* entity) {
+  eraseValue(byName[entity->getName()], entity);
+  eraseIfEmpty(byName, entity->getName());
+  switch (entity->getKind()) {
+    case EntityKind::Drone:
+      setAvailable(static_cast<Drone*>(entity), false);
+      break;
+    case EntityKind::Package:
+      closeRequest(nullptr, static_cast<Package*>(entity));
+      break;
+    case EntityKind::Robot:
+      closeRequest(static_cast<Robot*>(entity), nullptr);
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,79 @@
+#include "GreedyDispatcher.h"
+
+#include "SimulationModel.h"
+
+void GreedyDispatcher::dispatch(SimulationModel& model,
+                                std::deque<Package*>& pending) {
+  // loop through packages to schedule unplugDrone
+  int deliverySize = pending.size();
+  while (deliverySize > 0) {
+    int numAvailable = model.getEntities().availableCount();
+    //
+    Package* package = pending.front();
+    ChargingStation* endStation =
+        model.getBestRechargeStation(package->getDestination(),
+                                     kStationSpeed);
+    //
+    double packageDist = package->getPosition().dist(package->getDestination());
+    // calc distance between package location and destination
+    packageDist += package->getPosition().dist(endStation->getPosition());
+    // add distance from end position to recharge station
+    //
+    double bestSpeed = packageDist;
+    // set the best speed to a large number so minimum will be smaller
+    double bestWaitingSpeed = packageDist * 3;
+    // set best waiting speed to large number as well
+    double bestTotalDist = packageDist;
+    //
+    Drone* bestDrone = nullptr;
+    //
+    // only the weight classes above the package can carry it
+    const auto& available = model.getEntities().availableDrones();
+    for (auto weightClass = available.upper_bound(package->getPackageWeight());
+         weightClass != available.end(); ++weightClass) {
+      for (Drone* d : weightClass->second) {
+        //  calculate the distance between drone and package
+        double droneDist = package->getPosition().dist(d->getPosition());
+        //  does the battery have enough max capacity
+        if (d->getBatteryCapacity() > packageDist + droneDist) {
+          //  calc speed drone can do deliver in
+          double travelSpeed = (packageDist + droneDist) / d->getSpeed();
+          // does the battery have enough current charge
+          if (d->getBatteryCharge() > packageDist + droneDist) {
+            //
+            if (travelSpeed < bestSpeed) {
+              // set best non-waiting speed to current drone's speed
+              bestSpeed = travelSpeed;
+              // a non-waiting speed is available, ignore all waiting speeds
+              bestWaitingSpeed = -1;
+              bestDrone = d;
+              bestTotalDist = packageDist + droneDist;
+            }
+            // not enough current charge, enough battery capacity,
+            // and no non-waiting speed found
+          } else if (bestWaitingSpeed != -1) {
+            //
+            if (travelSpeed < bestWaitingSpeed) {
+              // set the waiting speed to the current drone's speed
+              bestWaitingSpeed = travelSpeed;
+              bestDrone = d;
+              bestTotalDist = packageDist + droneDist;
+            }
+            //
+          }
+        }
+      }
+    }
+    //
+    deliverySize--;
+    pending.pop_front();
+    if (numAvailable == 0 || !bestDrone) {
+      pending.push_back(package);
+      if (numAvailable == 0) break;
+      continue;
+    }
+    //
+    // no drones available, stop looking for them
+    bestDrone->setNextDelivery(package, bestTotalDist, endStation);
+  }
+}
@@ -8,19 +8,16 @@
 
 Helicopter::Helicopter(JsonObject& obj) : IEntity(obj) {}
 
-Helicopter::~Helicopter() {
-  if (movement) delete movement;
-}
+Helicopter::~Helicopter() {}
 
 void Helicopter::update(double dt) {
   if (movement && !movement->isCompleted()) {
     movement->move(this, dt);
   } else {
-    if (movement) delete movement;
     Vector3 dest;
-    dest.x = ((static_cast<double>(rand())) / RAND_MAX) * (2900) - 1400;
+    dest.x = random.uniform(-1400, 1500);
     dest.y = position.y;
-    dest.z = ((static_cast<double>(rand())) / RAND_MAX) * (1600) - 800;
-    movement = new BeelineStrategy(position, dest);
+    dest.z = random.uniform(-800, 800);
+    movement.reset(new BeelineStrategy(position, dest));
   }
 }
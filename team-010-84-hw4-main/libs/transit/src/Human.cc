@@ -9,20 +9,27 @@
 
 Human::Human(JsonObject& obj) : IEntity(obj) {}
 
-Human::~Human() {
-  if (movement) delete movement;
-}
+Human::~Human() {}
 
 void Human::update(double dt) {
   if (movement && !movement->isCompleted()) {
     movement->move(this, dt);
   } else {
-    if (movement) delete movement;
-    Vector3 dest;
-    dest.x = ((static_cast<double>(rand())) / RAND_MAX) * (2900) - 1400;
-    dest.y = position.y;
-    dest.z = ((static_cast<double>(rand())) / RAND_MAX) * (1600) - 800;
-    if (model)
-      movement = new AstarStrategy(position, dest, model->getGraph());
+    movement.reset();
+    RoutePool* routes = model ? model->getRoutePool() : nullptr;
+    if (routes && routes->size() > 1) {
+      // walk to the nearest hub first, then from hub to hub
+      if (hub < 0) hub = routes->nearestHub(position);
+      int next = random.uniform(0, routes->size() - 1);
+      if (next >= hub) next++;
+      movement.reset(new PathStrategy(routes->route(hub, next)));
+      hub = next;
+    } else if (model && model->getGraph()) {
+      Vector3 dest;
+      dest.x = random.uniform(-1400, 1500);
+      dest.y = position.y;
+      dest.z = random.uniform(-800, 800);
+      movement.reset(new AstarStrategy(position, dest, model->getGraph()));
+    }
   }
 }
@@ -0,0 +1,16 @@
+#include "IDispatcher.h"
+
+DeliveryQuote IDispatcher::quote(Drone* drone, Package* package,
+                                 ChargingStation* endStation) {
+  DeliveryQuote q;
+  if (package->getPackageWeight() >= drone->getWeight()) return q;
+
+  // drone to package, package to destination, destination to station
+  q.distance = drone->getPosition().dist(package->getPosition()) +
+               package->getPosition().dist(package->getDestination()) +
+               package->getDestination().dist(endStation->getPosition());
+  q.feasible = drone->getBatteryCapacity() > q.distance;
+  q.ready = drone->getBatteryCharge() > q.distance;
+  q.time = q.distance / drone->getSpeed();
+  return q;
+}
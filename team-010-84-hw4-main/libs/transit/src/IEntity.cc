@@ -1,10 +1,8 @@
 #include "IEntity.h"
 
-IEntity::IEntity() {
-  static int currentId = 0;
-  id = currentId;
-  currentId++;
-}
+#include "SimulationModel.h"
+
+IEntity::IEntity() {}
 
 IEntity::IEntity(JsonObject& details) : IEntity() {
   this->details = details;
@@ -23,14 +21,24 @@ IEntity::IEntity(JsonObject& details) : IEntity() {
 
 IEntity::~IEntity() {}
 
-void IEntity::linkModel(SimulationModel* model) {
+void IEntity::linkModel(SimulationModel* model, int id) {
   this->model = model;
+  this->id = id;
+  random = RandomStream(model->getSeed(), id);
 }
 
 int IEntity::getId() const {
   return id;
 }
 
+EntityKind IEntity::getKind() const {
+  return EntityKind::Other;
+}
+
+bool IEntity::isIdle() const {
+  return false;
+}
+
 Vector3 IEntity::getPosition() const {
   return position;
 }
@@ -47,7 +55,7 @@ std::string IEntity::getColor() const {
   return color;
 }
 
-std::string IEntity::getName() const {
+const std::string& IEntity::getName() const {
   return name;
 }
 
@@ -0,0 +1,20 @@
+#include "JumpCelebration.h"
+
+#include <algorithm>
+
+JumpCelebration::JumpCelebration(double time, double jumpHeight)
+  : Celebration(time), jumpHeight(jumpHeight) {}
+
+void JumpCelebration::act(IEntity* entity, double dt) {
+  // bounce between the ground and jumpHeight, however far dt carries it
+  double travel = entity->getSpeed() * dt;
+  double start = h;
+  while (travel > 0 && jumpHeight > 0) {
+    double room = up ? jumpHeight - h : h;
+    double step = std::min(room, travel);
+    h += up ? step : -step;
+    travel -= step;
+    if (step == room) up = !up;
+  }
+  entity->setPosition(entity->getPosition() + Vector3(0, h - start, 0));
+}
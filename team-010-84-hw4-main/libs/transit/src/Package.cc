@@ -1,6 +1,7 @@
 #include "Package.h"
 
 #include "Robot.h"
+#include "SimulationModel.h"
 
 Package::Package(JsonObject &obj) : IEntity(obj) {
 }
@@ -34,8 +35,17 @@ void Package::initDelivery(Robot* owner) {
   destination = owner->getPosition();
 }
 
+void Package::pickUp() {
+  carried = true;
+  if (model) model->wake(this);
+}
+
 void Package::handOff() {
+  carried = false;
   if (owner) {
     owner->receive(this);
   }
+  if (model) {
+    model->packageDelivered(this);
+  }
 }
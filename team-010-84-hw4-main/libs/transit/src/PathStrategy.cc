@@ -1,22 +1,59 @@
 #include "PathStrategy.h"
 
-PathStrategy::PathStrategy(std::vector<std::vector<float>> p)
-  : path(p), index(0) {}
+#include <algorithm>
 
-void PathStrategy::move(IEntity* entity, double dt) {
+PathStrategy::PathStrategy(const std::vector<std::vector<float>>& p)
+  : path(std::make_shared<const routing::WaypointBuffer>(p)), index(0) {}
+
+PathStrategy::PathStrategy(std::shared_ptr<const routing::WaypointBuffer> p)
+  : path(std::move(p)), index(0) {}
+
+double PathStrategy::move(IEntity* entity, double dt) {
   if (isCompleted())
-    return;
+    return dt;
 
-  Vector3 vi(path[index][0], path[index][1], path[index][2]);
-  Vector3 dir = (vi - entity->getPosition()).unit();
+  double speed = entity->getSpeed();
+  double travel = speed * dt;
+  const routing::WaypointBuffer& points = *path;
+  if (index == 0) {
+    // head for the start of the path from wherever the entity is
+    Vector3 start(points[0].x, points[0].y, points[0].z);
+    Vector3 offset = start - entity->getPosition();
+    double remaining = offset.normalizeAndLength();
+    if (remaining > travel) {
+      entity->setDirection(offset);
+      entity->setPosition(entity->getPosition() + offset * travel);
+      return 0;
+    }
+    travel -= remaining;
+    index = 1;
+  }
 
-  entity->setPosition(entity->getPosition() + dir*entity->getSpeed()*dt);
-  entity->setDirection(dir);
+  // every waypoint the distance travelled reaches is passed; travel past
+  // the end is handed back as time
+  double beyond = std::max<double>(0, along + travel - points.Length());
+  double unused = beyond > 0 && speed > 0 ? beyond / speed : 0;
+  along = std::min<double>(along + travel, points.Length());
+  while (index < points.Size() && points[index].distance <= along) index++;
 
-  if (entity->getPosition().dist(vi) < 4)
-    index++;
+  // the segment the entity ends up on, or the last one with any length
+  int to = std::min(index, points.Size() - 1);
+  while (to > 0 && points[to].distance <= points[to - 1].distance) to--;
+  if (to == 0) {
+    entity->setPosition(Vector3(points[0].x, points[0].y, points[0].z));
+    return unused;
+  }
+  const routing::Waypoint& a = points[to - 1];
+  const routing::Waypoint& b = points[to];
+  Vector3 from(a.x, a.y, a.z);
+  Vector3 next(b.x, b.y, b.z);
+  double length = b.distance - a.distance;
+  double t = std::min(1.0, (along - a.distance) / length);
+  entity->setPosition(from.lerp(next, t));
+  entity->setDirection((next - from) / length);
+  return unused;
 }
 
 bool PathStrategy::isCompleted() {
-  return index >= path.size();
+  return index >= path->Size();
 }
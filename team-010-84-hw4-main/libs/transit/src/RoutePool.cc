@@ -0,0 +1,65 @@
+#include "RoutePool.h"
+
+#include <limits>
+
+#include "routing/astar.h"
+
+RoutePool::RoutePool(const routing::IGraph* graph, int count,
+                     RandomStream random, Vector3 low, Vector3 high)
+    : graph(graph) {
+  // hubs lie on the map, so routes start and end exactly at them
+  routing::BoundingBox box = graph->GetBoundingBox();
+  float y = (box.min[1] + box.max[1]) / 2;
+  std::vector<const routing::IGraphNode*> nodes;
+  for (int i = 0; i < count; i++) {
+    float x = random.uniform(low.x, high.x);
+    float z = random.uniform(low.z, high.z);
+    const routing::IGraphNode* node =
+        graph->NearestNode({x, y, z}, routing::EuclideanDistance());
+    bool known = false;
+    for (const routing::IGraphNode* hub : nodes) known = known || hub == node;
+    if (known) continue;
+    nodes.push_back(node);
+    hubs.push_back(node->GetPosition());
+  }
+  routes.reset(new Route[hubs.size() * hubs.size()]);
+  warmer = std::thread(&RoutePool::warm, this);
+}
+
+RoutePool::~RoutePool() {
+  stopping = true;
+  warmer.join();
+}
+
+int RoutePool::nearestHub(const Vector3& position) const {
+  int nearest = 0;
+  double best = std::numeric_limits<double>::infinity();
+  for (int i = 0; i < hubs.size(); i++) {
+    double dist = position.dist(Vector3(hubs[i][0], hubs[i][1], hubs[i][2]));
+    if (dist < best) {
+      best = dist;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+std::shared_ptr<const routing::WaypointBuffer> RoutePool::route(int from,
+                                                                int to) {
+  Route& route = routes[from * hubs.size() + to];
+  std::call_once(route.computed, [&]() {
+    route.path =
+        graph->GetRoute(hubs[from], hubs[to], routing::AStar::Default());
+    routesFound++;
+  });
+  return route.path;
+}
+
+void RoutePool::warm() {
+  for (int from = 0; from < hubs.size(); from++) {
+    for (int to = 0; to < hubs.size(); to++) {
+      if (stopping) return;
+      if (from != to) route(from, to);
+    }
+  }
+}
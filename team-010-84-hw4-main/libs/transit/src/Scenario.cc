@@ -0,0 +1,73 @@
+#include "Scenario.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+void Scenario::load(const std::string& file) {
+  std::ifstream in(file);
+  if (!in) throw std::runtime_error("cannot open " + file);
+  std::stringstream text;
+  text << in.rdbuf();
+
+  picojson::value parsed;
+  std::string error = picojson::parse(parsed, text.str());
+  if (!error.empty()) throw std::runtime_error(file + ": " + error);
+  if (!parsed.is<picojson::array>()) {
+    throw std::runtime_error(file + ": expected an array of commands");
+  }
+
+  std::vector<ScenarioCommand> loaded;
+  for (const picojson::value& entry : parsed.get<picojson::array>()) {
+    if (!entry.is<picojson::object>()) continue;
+    JsonObject object = JsonValue(entry);
+    if (!object.contains("command") || !object.contains("params")) continue;
+
+    ScenarioCommand command;
+    command.command = static_cast<std::string>(object["command"]);
+    if (command.command != "CreateEntity" && command.command != "ScheduleTrip") {
+      continue;
+    }
+    command.params = object["params"];
+    if (object.contains("time")) command.time = object["time"];
+    loaded.push_back(command);
+  }
+
+  // commands already run stay put; the rest merge in by time
+  commands.insert(commands.end(), loaded.begin(), loaded.end());
+  std::stable_sort(commands.begin() + next, commands.end(),
+                   [](const ScenarioCommand& a, const ScenarioCommand& b) {
+                     return a.time < b.time;
+                   });
+}
+
+void Scenario::add(const ScenarioCommand& command) {
+  auto at = std::upper_bound(
+      commands.begin() + next, commands.end(), command.time,
+      [](double time, const ScenarioCommand& c) { return time < c.time; });
+  commands.insert(at, command);
+}
+
+int Scenario::apply(SimulationModel& model, double time) {
+  int applied = 0;
+  while (next < commands.size() && commands[next].time <= time) {
+    ScenarioCommand& command = commands[next++];
+    if (command.command == "CreateEntity") {
+      model.createEntity(command.params);
+    } else {
+      model.scheduleTrip(command.params);
+    }
+    applied++;
+  }
+  return applied;
+}
+
+double Scenario::nextTime() const {
+  return done() ? std::numeric_limits<double>::infinity() : commands[next].time;
+}
+
+double Scenario::endTime() const {
+  return commands.empty() ? 0 : commands.back().time;
+}
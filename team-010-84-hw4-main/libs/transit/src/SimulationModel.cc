@@ -1,5 +1,9 @@
 #include "SimulationModel.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "BatchDispatcher.h"
 #include "ChargingStationFactory.h"
 #include "DroneFactory.h"
 #include "HelicopterFactory.h"
@@ -7,6 +11,14 @@
 #include "PackageFactory.h"
 #include "RobotFactory.h"
 
+namespace {
+
+// Effects deferred by the entity this thread is updating, or nullptr
+// outside a parallel update.
+thread_local std::vector<std::function<void()>>* deferredEffects = nullptr;
+
+}  // namespace
+
 SimulationModel::SimulationModel(IController& controller)
     : controller(controller) {
   entityFactory.AddFactory(new DroneFactory());
@@ -15,14 +27,14 @@ SimulationModel::SimulationModel(IController& controller)
   entityFactory.AddFactory(new HumanFactory());
   entityFactory.AddFactory(new HelicopterFactory());
   entityFactory.AddFactory(new ChargingStationFactory());
+  setDispatcher(new BatchDispatcher(), 1.0);
 }
 
 SimulationModel::~SimulationModel() {
   // Delete dynamically allocated variables
-  for (auto& [id, entity] : entities) {
-    delete entity;
-  }
-  delete graph;
+  entities.forEach([](IEntity* entity) { delete entity; });
+  delete dispatcher;
+  delete workers;
 }
 
 IEntity* SimulationModel::createEntity(JsonObject& entity) {
@@ -34,14 +46,97 @@ IEntity* SimulationModel::createEntity(JsonObject& entity) {
   IEntity* myNewEntity = nullptr;
   if (myNewEntity = entityFactory.CreateEntity(entity)) {
     // Call AddEntity to add it to the view
-    myNewEntity->linkModel(this);
+    myNewEntity->linkModel(this, nextId++);
+    if (myNewEntity->getKind() == EntityKind::Human && graph && !routePool) {
+      // humans wander around campus; ids are never negative, so stream -1
+      // is the pool's own
+      routePool.reset(new RoutePool(graph, walkingHubs, RandomStream(seed, -1),
+                                    Vector3(-1400, 0, -800),
+                                    Vector3(1500, 0, 800)));
+    }
     controller.addEntity(*myNewEntity);
-    entities[myNewEntity->getId()] = myNewEntity;
+    entities.add(myNewEntity);
+    if (myNewEntity->getKind() == EntityKind::ChargingStation) indexStations();
   }
   // std::cout << "Created entity succesfully\n";
   return myNewEntity;
 }
 
+void SimulationModel::setDispatcher(IDispatcher* dispatcher,
+                                    double interval) {
+  delete this->dispatcher;
+  this->dispatcher = dispatcher;
+  dispatchInterval = interval;
+}
+
+void SimulationModel::setWorkerThreads(int threads) {
+  delete workers;
+  workers = threads > 1 ? new ThreadPool(threads - 1) : nullptr;
+}
+
+void SimulationModel::defer(std::function<void()> effect) {
+  if (deferredEffects) {
+    deferredEffects->push_back(std::move(effect));
+  } else {
+    effect();
+  }
+}
+
+template <class T>
+void SimulationModel::updateAll(const std::vector<T*>& items, double dt) {
+  if (!workers) {
+    for (T* item : items) item->update(dt);
+    sleepIdle(items);
+    return;
+  }
+  // compute: each entity updates itself and queues its effects on others.
+  // A chunk's effects are filed under its first entity, so reading the
+  // buffers in index order replays them in entity order.
+  std::vector<std::vector<std::function<void()>>> effects(items.size());
+  workers->parallelFor(items.size(), [&](int begin, int end) {
+    deferredEffects = &effects[begin];
+    for (int i = begin; i < end; i++) items[i]->update(dt);
+    deferredEffects = nullptr;
+  });
+  // commit: apply the effects serially
+  for (auto& queued : effects) {
+    for (auto& effect : queued) effect();
+  }
+  sleepIdle(items);
+}
+
+template <class T>
+void SimulationModel::sleepIdle(const std::vector<T*>& items) {
+  for (T* item : items) {
+    if (item->isIdle()) entities.setAwake(item, false);
+  }
+}
+
+void SimulationModel::wake(IEntity* entity) { entities.setAwake(entity, true); }
+
+void SimulationModel::wakeAt(IEntity* entity, double at) {
+  wakeups.push({at, entity->getId()});
+}
+
+double SimulationModel::nextEventTime() const {
+  if (entities.awakeCount() > 0) return time;
+  double next = std::numeric_limits<double>::infinity();
+  if (!wakeups.empty()) next = std::max(time, wakeups.top().first);
+  if (!scheduledDeliveries.empty()) {
+    next = std::min(next, time + std::max(0.0, dispatchInterval - sinceDispatch));
+  }
+  return next;
+}
+
+double SimulationModel::skipTo(double until) {
+  double to = std::min(until, nextEventTime());
+  if (to > time) {
+    sinceDispatch += to - time;
+    time = to;
+  }
+  return time;
+}
+
 void SimulationModel::removeEntity(int id) { removed.insert(id); }
 
 /// Schedules a Delivery for an object in the scene
@@ -51,38 +146,17 @@ void SimulationModel::scheduleTrip(JsonObject& details) {
   JsonArray end = details["end"];
   // std::cout << name << ": " << start << " --> " << end << std::endl;
 
-  Robot* receiver = nullptr;
-
-  for (auto& [id, entity] : entities) {
-    if (name == entity->getName()) {
-      if (Robot* r = dynamic_cast<Robot*>(entity)) {
-        if (r->requestedDelivery) {
-          receiver = r;
-          break;
-        }
-      }
-    }
-  }
-
-  Package* package = nullptr;
-
-  for (auto& [id, entity] : entities) {
-    if (name + "_package" == entity->getName()) {
-      if (Package* p = dynamic_cast<Package*>(entity)) {
-        if (p->requiresDelivery) {
-          package = p;
-          break;
-        }
-      }
-    }
-  }
+  Robot* receiver = entities.openRequest(name);
+  Package* package = entities.openPackage(name + "_package");
 
   if (receiver && package) {
     package->initDelivery(receiver);
+    entities.closeRequest(receiver, package);
     package->setPackageWeight(details["weight"]);
     std::string strategyName = details["search"];
     package->setStrategyName(strategyName);
     scheduledDeliveries.push_back(package);
+    deliveries.scheduled(package->getId(), package->getName(), time);
     controller.sendEventToView("DeliveryScheduled", details);
   }
 }
@@ -90,141 +164,130 @@ void SimulationModel::scheduleTrip(JsonObject& details) {
 const routing::IGraph* SimulationModel::getGraph() { return graph; }
 
 ChargingStation* SimulationModel::getClosestRechargeStation(Vector3 position) {
-  ChargingStation* bestStation = nullptr;
-  double bestDist = -1;
-  for (auto& [id, entity] : entities) {
-    if (ChargingStation* c = dynamic_cast<ChargingStation*>(entity)) {
-      // get distance from current station to package
-      double curDist = position.dist(c->getPosition());
-      if (bestDist == -1) {
-        bestDist = curDist;
-        bestStation = c;
-      } else if (curDist < bestDist) {
-        bestDist = curDist;
-        bestStation = c;
-      }
+  const std::vector<ChargingStation*>& stations = entities.stations();
+  int best = stationGrid.cheapest(position, [&](int i, double) {
+    return position.dist(stations[i]->getPosition());
+  });
+  return best < 0 ? nullptr : stations[best];
+}
+
+ChargingStation* SimulationModel::getBestRechargeStation(
+    Vector3 position, double speed,
+    const std::unordered_map<ChargingStation*, StationLoad>* tentative) {
+  // waiting is priced as the distance the drone could have flown meanwhile
+  const std::vector<ChargingStation*>& stations = entities.stations();
+  int best = stationGrid.cheapest(position, [&](int i, double) {
+    StationLoad extra;
+    if (tentative) {
+      auto load = tentative->find(stations[i]);
+      if (load != tentative->end()) extra = load->second;
     }
+    return position.dist(stations[i]->getPosition()) +
+           speed * stations[i]->estimatedWait(extra);
+  });
+  return best < 0 ? nullptr : stations[best];
+}
+
+void SimulationModel::indexStations() {
+  // ids in the grid are positions in entities.stations(), which removals
+  // reorder, so the grid is rebuilt whenever a station comes or goes
+  stationGrid = SpatialGrid(kStationCell);
+  const std::vector<ChargingStation*>& stations = entities.stations();
+  for (int i = 0; i < stations.size(); i++) {
+    stationGrid.insert(i, stations[i]->getPosition());
   }
-  return bestStation;
 }
 
 /// Updates the simulation
 void SimulationModel::update(double dt) {
-  // std::cout << "Updating\n";
+  while (!wakeups.empty() && wakeups.top().first <= time) {
+    IEntity* entity = entities.get(wakeups.top().second);
+    if (entity) wake(entity);
+    wakeups.pop();
+  }
+  // each system walks only the awake entities it needs
+  updateDrones(dt);
+  updateStations(dt);
+  updateOthers(dt);
+  //
+  for (int id : removed) {  // remove deleted entities from sim
+    removeFromSim(id);
+  }
+  dispatchDeliveries(dt);
+  //
+  removed.clear();
+  time += dt;
+}
+
+void SimulationModel::packageAssigned(Package* package) {
+  deliveries.assigned(package->getId(), time);
+}
+
+void SimulationModel::packageDelivered(Package* package) {
+  deliveries.delivered(package->getId(), time);
+}
+
+void SimulationModel::updateDrones(double dt) {
+  // copied, as entities fall asleep or wake while the copy is walked
+  std::vector<Drone*> awake = entities.awakeDrones();
+  updateAll(awake, dt);
+  for (Drone* d : awake) controller.updateEntity(*d);
+
+  // batteries only change while drones fly or charge
+  if (awake.empty() && charging == 0) return;
   JsonArray batteryCharges;
-  int droneIdx = 0;
-  for (auto& [id, entity] : entities) {  // update all entities
-    entity->update(dt);
-    controller.updateEntity(*entity);
-    //
-    Drone* d = dynamic_cast<Drone*>(entity);
-    if (d) {
-      batteryCharges.push(
-          JsonValue(100 * d->getBatteryCharge() /
-                    static_cast<double>(d->getBatteryCapacity())));
-      droneIdx++;
-    }
+  for (Drone* d : entities.drones()) {
+    batteryCharges.push(
+        JsonValue(100 * d->getBatteryCharge() /
+                  static_cast<double>(d->getBatteryCapacity())));
   }
   //
   JsonObject batteryDetails;
   batteryDetails["batteries"] = batteryCharges;
   controller.sendEventToView("UpdateBatteries", batteryDetails);
-  //
-  for (int id : removed) {  // remove deleted entities from sim
-    removeFromSim(id);
+}
+
+void SimulationModel::updateStations(double dt) {
+  std::vector<ChargingStation*> awake = entities.awakeStations();
+  for (ChargingStation* c : awake) {
+    c->update(dt);
+    controller.updateEntity(*c);
   }
-  // loop through packages to schedule unplugDrone
-  int deliverySize = scheduledDeliveries.size();
-  while (deliverySize > 0) {
-    // std::cout << "Entering deliveries\n";
-    int bestBattery;
-    int numAvailable = 0;
-    //
-    Package* package = scheduledDeliveries.front();
-    ChargingStation* endStation =
-        getClosestRechargeStation(package->getDestination());
-    //
-    double packageDist = package->getPosition().dist(package->getDestination());
-    // calc distance between package location and destination
-    packageDist += package->getPosition().dist(endStation->getPosition());
-    // add distance from end position to recharge station
-    //
-    double bestSpeed = packageDist;
-    // set the best speed to a large number so minimum will be smaller
-    double bestWaitingSpeed = packageDist * 3;
-    // set best waiting speed to large number as well
-    double bestTotalDist = packageDist;
-    //
-    Drone* bestDrone = nullptr;
-    //
-    for (auto& [id, entity] : entities) {
-      Drone* d = dynamic_cast<Drone*>(entity);
-      // is the entity an available drone
-      if (d && d->getAvailability()) {
-        // does the drone have a high enough weight capacity
-        if (package->getPackageWeight() < d->getWeight()) {
-          // std::cout << "Drone with weight capacity found\n";
-          //  calculate the distance between drone and package
-          double droneDist = package->getPosition().dist(d->getPosition());
-          // std::cout << "droneDist: " << packageDist + droneDist << "\n";
-          //  does the battery have enough max capacity
-          if (d->getBatteryCapacity() > packageDist + droneDist) {
-            // std::cout << "Drone with battery capacity found\n";
-            //  calc speed drone can do deliver in
-            double travelSpeed = (packageDist + droneDist) / d->getSpeed();
-            // does the battery have enough current charge
-            if (d->getBatteryCharge() > packageDist + droneDist) {
-              // std::cout << "Drone with battery charge found\n";
-              //
-              if (travelSpeed < bestSpeed) {
-                // set best non-waiting speed to current drone's speed
-                bestSpeed = travelSpeed;
-                // a non-waiting speed is available, ignore all waiting speeds
-                bestWaitingSpeed = -1;
-                bestDrone = d;
-                bestTotalDist = packageDist + droneDist;
-              }
-              // not enough current charge, enough battery capacity,
-              // and no non-waiting speed found
-            } else if (bestWaitingSpeed != -1) {
-              // std::cout << "Drone with not enough battery charge found\n";
-              //
-              if (travelSpeed < bestWaitingSpeed) {
-                // set the waiting speed to the current drone's speed
-                bestWaitingSpeed = travelSpeed;
-                bestDrone = d;
-                bestTotalDist = packageDist + droneDist;
-              }
-              //
-            }
-          }
-        }
-        numAvailable++;
-      }
-    }
-    //
-    // std::cout << "Finished drone finding\n";
-    deliverySize--;
-    scheduledDeliveries.pop_front();
-    if (numAvailable == 0 || !bestDrone) {
-      // std::cout << "No suitable drone\n";
-      scheduledDeliveries.push_back(package);
-      if (numAvailable == 0) break;
-      continue;
-    }
-    //
-    // std::cout << "best total: " << bestTotalDist << std::endl;
-    // no drones available, stop looking for them
-    bestDrone->setNextDelivery(package, bestTotalDist, endStation);
+  sleepIdle(awake);
+}
+
+void SimulationModel::updateOthers(double dt) {
+  std::vector<Package*> packages = entities.awakePackages();
+  for (Package* p : packages) {
+    p->update(dt);
+    controller.updateEntity(*p);
   }
-  //
-  removed.clear();
+  sleepIdle(packages);
+  std::vector<Robot*> robots = entities.awakeRobots();
+  for (Robot* r : robots) {
+    r->update(dt);
+    controller.updateEntity(*r);
+  }
+  sleepIdle(robots);
+  std::vector<IEntity*> others = entities.awakeOthers();
+  updateAll(others, dt);
+  for (IEntity* entity : others) {
+    controller.updateEntity(*entity);
+  }
+}
+
+void SimulationModel::dispatchDeliveries(double dt) {
+  // batch up requests between dispatches instead of retrying every update
+  sinceDispatch += dt;
+  if (sinceDispatch < dispatchInterval || scheduledDeliveries.empty()) return;
+  sinceDispatch = 0;
+  dispatcher->dispatch(*this, scheduledDeliveries);
 }
 
 void SimulationModel::stop(void) { controller.stop(); }
 
 void SimulationModel::removeFromSim(int id) {
-  IEntity* entity = entities[id];
+  IEntity* entity = entities.get(id);
   if (entity) {
     for (auto i = scheduledDeliveries.begin(); i != scheduledDeliveries.end();
          ++i) {
@@ -234,7 +297,9 @@ void SimulationModel::removeFromSim(int id) {
       }
     }
     controller.removeEntity(*entity);
-    entities.erase(id);
+    bool station = entity->getKind() == EntityKind::ChargingStation;
+    entities.remove(id);
+    if (station) indexStations();
     delete entity;
   }
 }
@@ -0,0 +1,194 @@
+#include "SimulationThread.h"
+
+#include <chrono>
+
+namespace {
+
+// How far the thread may fall behind before it gives up catching up.
+const int kMaxLagTicks = 10;
+
+// How many ticks of changes are kept to bring old snapshots up to date.
+const int kHistoryTicks = 64;
+
+}  // namespace
+
+EntityState EntityState::of(const IEntity& entity) {
+  EntityState state;
+  state.id = entity.getId();
+  state.position = entity.getPosition();
+  state.direction = entity.getDirection();
+  state.color = entity.getColor();
+  return state;
+}
+
+JsonObject EntityState::toJson() const {
+  JsonObject details;
+  details["id"] = id;
+  details["pos"] = JsonArray({position.x, position.y, position.z});
+  details["dir"] = JsonArray({direction.x, direction.y, direction.z});
+  if (color != "") details["color"] = color;
+  return details;
+}
+
+SimulationThread::SimulationThread(double tickRate)
+    : model(*this), tickRate(tickRate) {}
+
+SimulationThread::~SimulationThread() {
+  alive = false;
+  if (thread.joinable()) thread.join();
+}
+
+void SimulationThread::start() {
+  if (!thread.joinable()) thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::post(std::function<void(SimulationModel&)> command) {
+  std::lock_guard<std::mutex> lock(commandMutex);
+  commands.push_back(std::move(command));
+}
+
+const WorldSnapshot& SimulationThread::latest() {
+  snapshots.update();
+  return snapshots.front();
+}
+
+std::vector<SimulationEvent> SimulationThread::drainEvents() {
+  std::vector<SimulationEvent> drained;
+  std::lock_guard<std::mutex> lock(eventMutex);
+  drained.swap(events);
+  return drained;
+}
+
+void SimulationThread::addEntity(const IEntity& entity) {
+  JsonObject details = EntityState::of(entity).toJson();
+  details["details"] = entity.getDetails();
+  queueEvent("AddEntity", details);
+  changed(entity.getId());
+}
+
+void SimulationThread::updateEntity(const IEntity& entity) {
+  changed(entity.getId());
+}
+
+void SimulationThread::removeEntity(const IEntity& entity) {
+  changed(entity.getId());
+  changedAt.erase(entity.getId());
+  JsonObject details;
+  details["id"] = entity.getId();
+  queueEvent("RemoveEntity", details);
+}
+
+void SimulationThread::sendEventToView(const std::string& event,
+                                       const JsonObject& details) {
+  queueEvent(event, details);
+}
+
+void SimulationThread::queueEvent(const std::string& event,
+                                  const JsonObject& details) {
+  std::lock_guard<std::mutex> lock(eventMutex);
+  events.push_back({event, details});
+}
+
+void SimulationThread::run() {
+  typedef std::chrono::steady_clock clock;
+  const clock::duration period =
+      std::chrono::duration_cast<clock::duration>(
+          std::chrono::duration<double>(1.0 / tickRate));
+  const double step = 1.0 / tickRate;
+
+  clock::time_point next = clock::now();
+  while (alive) {
+    runCommands();
+
+    // paths are followed exactly at any dt, so one update covers the tick
+    model.update(step * speed);
+    time += step * speed;
+    tick++;
+    publish();
+
+    // fixed timestep: sleep to the next tick, or skip ahead when too slow
+    next += period;
+    clock::time_point now = clock::now();
+    if (now - next > kMaxLagTicks * period) {
+      next = now;
+    } else {
+      std::this_thread::sleep_until(next);
+    }
+  }
+}
+
+void SimulationThread::runCommands() {
+  std::deque<std::function<void(SimulationModel&)>> pending;
+  {
+    std::lock_guard<std::mutex> lock(commandMutex);
+    pending.swap(commands);
+  }
+  for (auto& command : pending) command(model);
+}
+
+void SimulationThread::changed(int id) {
+  // the tick under way, which is published as tick + 1
+  changes.push_back({tick + 1, id});
+  changedAt[id] = tick + 1;
+}
+
+void SimulationThread::publish() {
+  WorldSnapshot& snapshot = snapshots.back();
+  if (snapshot.tick < forgotten) {
+    rebuild(snapshot);
+  } else {
+    catchUp(snapshot);
+  }
+  snapshot.tick = tick;
+  snapshot.time = time;
+  snapshots.publish();
+
+  while (!changes.empty() && changes.front().first <= tick - kHistoryTicks) {
+    forgotten = changes.front().first;
+    changes.pop_front();
+  }
+}
+
+void SimulationThread::catchUp(WorldSnapshot& snapshot) {
+  // the back buffer is a few ticks old; replay what changed since
+  auto first = changes.end();
+  while (first != changes.begin() && (first - 1)->first > snapshot.tick) {
+    --first;
+  }
+  const EntityStore& store = model.getEntities();
+  for (auto change = first; change != changes.end(); ++change) {
+    int id = change->second;
+    auto slot = snapshot.slots.find(id);
+    IEntity* entity = store.get(id);
+    if (entity) {
+      EntityState state = EntityState::of(*entity);
+      state.changed = changedAt[id];
+      if (slot != snapshot.slots.end()) {
+        snapshot.entities[slot->second] = std::move(state);
+      } else {
+        snapshot.slots[id] = snapshot.entities.size();
+        snapshot.entities.push_back(std::move(state));
+      }
+    } else if (slot != snapshot.slots.end()) {
+      // removed: move the last state into its place
+      int index = slot->second;
+      snapshot.slots.erase(slot);
+      if (index != snapshot.entities.size() - 1) {
+        snapshot.entities[index] = std::move(snapshot.entities.back());
+        snapshot.slots[snapshot.entities[index].id] = index;
+      }
+      snapshot.entities.pop_back();
+    }
+  }
+}
+
+void SimulationThread::rebuild(WorldSnapshot& snapshot) {
+  snapshot.entities.clear();
+  snapshot.slots.clear();
+  model.getEntities().forEach([&](IEntity* entity) {
+    EntityState state = EntityState::of(*entity);
+    state.changed = changedAt[entity->getId()];
+    snapshot.slots[state.id] = snapshot.entities.size();
+    snapshot.entities.push_back(std::move(state));
+  });
+}
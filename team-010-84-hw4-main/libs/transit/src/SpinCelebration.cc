@@ -0,0 +1,8 @@
+#include "SpinCelebration.h"
+
+SpinCelebration::SpinCelebration(double time, double spinSpeed)
+  : Celebration(time), spinSpeed(spinSpeed) {}
+
+void SpinCelebration::act(IEntity* entity, double dt) {
+  entity->rotate(dt*entity->getSpeed()*spinSpeed);
+}
@@ -0,0 +1,68 @@
+#include "StateFrame.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const char kBase64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int16_t quantize(double value, double scale) {
+  double scaled = std::round(value * scale);
+  return static_cast<int16_t>(std::max(-32767.0, std::min(32767.0, scaled)));
+}
+
+}  // namespace
+
+StateFrame::StateFrame(long tick) {
+  bytes.reserve(kHeaderBytes + 64 * kRecordBytes);
+  put32(static_cast<uint32_t>(tick));
+  put32(0);  // count, filled in by toText
+}
+
+void StateFrame::add(const EntityState& state) {
+  put32(static_cast<uint32_t>(state.id));
+  put16(state.color.empty() ? 0 : kHasColor);
+  for (int i = 0; i < 3; i++) {
+    put16(quantize(state.position[i], kPositionScale));
+  }
+  Vector3 direction = state.direction.unit();
+  for (int i = 0; i < 3; i++) {
+    put16(quantize(direction[i], kDirectionScale));
+  }
+  count++;
+}
+
+std::string StateFrame::toText() const {
+  std::string payload = bytes;
+  for (int i = 0; i < 4; i++) {
+    payload[4 + i] = static_cast<char>((count >> (8 * i)) & 0xff);
+  }
+
+  std::string text(1, kMarker);
+  text.reserve(1 + (payload.size() + 2) / 3 * 4);
+  for (std::size_t i = 0; i < payload.size(); i += 3) {
+    uint32_t group = static_cast<uint8_t>(payload[i]) << 16;
+    if (i + 1 < payload.size()) {
+      group |= static_cast<uint8_t>(payload[i + 1]) << 8;
+    }
+    if (i + 2 < payload.size()) group |= static_cast<uint8_t>(payload[i + 2]);
+    text += kBase64[(group >> 18) & 63];
+    text += kBase64[(group >> 12) & 63];
+    text += i + 1 < payload.size() ? kBase64[(group >> 6) & 63] : '=';
+    text += i + 2 < payload.size() ? kBase64[group & 63] : '=';
+  }
+  return text;
+}
+
+void StateFrame::put16(uint16_t value) {
+  bytes += static_cast<char>(value & 0xff);
+  bytes += static_cast<char>(value >> 8);
+}
+
+void StateFrame::put32(uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    bytes += static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
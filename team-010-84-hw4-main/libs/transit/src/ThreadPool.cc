@@ -0,0 +1,75 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+
+// Chunks per thread, so a thread that draws slow entities does not hold
+// up the rest.
+const int kChunksPerThread = 4;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int threads) {
+  for (int i = 0; i < threads; i++) {
+    workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::parallelFor(int count,
+                             const std::function<void(int, int)>& work) {
+  if (workers.empty() || count < 2) {
+    work(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &work;
+    jobCount = count;
+    chunkSize = std::max(1, count / (kChunksPerThread * size()));
+    chunks = (count + chunkSize - 1) / chunkSize;
+    nextChunk = 0;
+    active = workers.size();
+    generation++;
+  }
+  wake.notify_all();
+  runChunks();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [this] { return active == 0; });
+  job = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+  long seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping) return;
+      seen = generation;
+    }
+    runChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--active == 0) done.notify_one();
+    }
+  }
+}
+
+void ThreadPool::runChunks() {
+  for (int chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) {
+    int begin = chunk * chunkSize;
+    (*job)(begin, std::min(jobCount, begin + chunkSize));
+  }
+}
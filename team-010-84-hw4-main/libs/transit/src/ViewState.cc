@@ -0,0 +1,44 @@
+#include "ViewState.h"
+
+std::vector<const EntityState*> ViewState::update(
+    const WorldSnapshot& snapshot) {
+  std::vector<const EntityState*> states;
+  bool keyframe =
+      lastTick < 0 || snapshot.tick - lastKeyframe >= kKeyframeTicks;
+  for (const EntityState& state : snapshot.entities) {
+    // between keyframes, skip what has not changed since the last look
+    if (!keyframe && state.changed <= lastTick) continue;
+    if (!needs(state, keyframe)) continue;
+    sent[state.id] = {state.position, state.direction};
+    states.push_back(&state);
+  }
+
+  if (keyframe) {
+    // forget entities that have been removed
+    for (auto i = sent.begin(); i != sent.end();) {
+      if (snapshot.slots.count(i->first)) {
+        ++i;
+      } else {
+        i = sent.erase(i);
+      }
+    }
+    lastKeyframe = snapshot.tick;
+  }
+  lastTick = snapshot.tick;
+  return states;
+}
+
+bool ViewState::needs(const EntityState& state, bool keyframe) {
+  auto last = sent.find(state.id);
+  if (last == sent.end()) return true;
+  const Sent& was = last->second;
+  if (keyframe) {
+    return state.position.distSquared(was.position) > 0 ||
+           state.direction.distSquared(was.direction) > 0;
+  }
+  if (state.position.distSquared(was.position) >
+      kPositionThreshold * kPositionThreshold) {
+    return true;
+  }
+  return state.direction.unit() * was.direction.unit() < kDirectionCosine;
+}